@@ -0,0 +1,143 @@
+#ifndef ALLIUM_BENCHMARK_BENCHMARK_HPP
+#define ALLIUM_BENCHMARK_BENCHMARK_HPP
+
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace benchmark {
+
+    // Prevents the compiler from discarding the computation of the value.
+    template <class T>
+    inline void do_not_optimize(T const& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    inline void clobber_memory()
+    {
+        asm volatile("" : : : "memory");
+    }
+
+    using function_type = std::function<void(std::uint64_t)>;
+
+    struct result
+    {
+        std::string name;
+        std::uint64_t iterations;
+        double nanoseconds_per_iteration;
+    };
+
+    struct run_options
+    {
+        std::string filter;
+        std::chrono::milliseconds min_time{200};
+        std::size_t repetitions = 5;
+    };
+
+    class registry
+    {
+        using clock = std::chrono::steady_clock;
+
+    public:
+        static auto instance()
+            -> registry&
+        {
+            static registry reg;
+            return reg;
+        }
+
+        void add(std::string name, function_type function)
+        {
+            benchmarks_.emplace_back(std::move(name), std::move(function));
+        }
+
+        // Runs each benchmark with enough iterations to take min_time,
+        // and reports the median of the repetitions.
+        auto run(run_options const& options, std::ostream& os) const
+            -> std::vector<result>
+        {
+            auto results = std::vector<result>{};
+            os << "name,iterations,ns_per_iteration" << std::endl;
+            for (auto const& benchmark : benchmarks_) {
+                if (benchmark.first.find(options.filter) == std::string::npos) {
+                    continue;
+                }
+                auto const iterations
+                    = calibrate(benchmark.second, options.min_time);
+                auto times = std::vector<double>{};
+                for (auto i = std::size_t{0}; i < options.repetitions; ++i) {
+                    auto const elapsed = measure(benchmark.second, iterations);
+                    times.push_back(double(elapsed.count()) / iterations);
+                }
+                std::sort(times.begin(), times.end());
+                results.push_back(result{
+                    benchmark.first, iterations, times[times.size() / 2]
+                });
+                os << results.back().name << ","
+                   << results.back().iterations << ","
+                   << std::fixed << std::setprecision(2)
+                   << results.back().nanoseconds_per_iteration << std::endl;
+            }
+            return results;
+        }
+
+    private:
+        static auto measure(
+                function_type const& function, std::uint64_t const iterations)
+            -> std::chrono::nanoseconds
+        {
+            auto const start = clock::now();
+            function(iterations);
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    clock::now() - start);
+        }
+
+        static auto calibrate(
+                function_type const& function
+              , std::chrono::milliseconds const min_time)
+            -> std::uint64_t
+        {
+            auto iterations = std::uint64_t{1};
+            while (true) {
+                auto const elapsed = measure(function, iterations);
+                if (elapsed >= min_time || iterations >= (1ULL << 40)) {
+                    return iterations;
+                }
+                if (elapsed * 10 < min_time) {
+                    iterations *= 10;
+                    continue;
+                }
+                return std::max<std::uint64_t>(
+                        iterations
+                      , iterations * min_time.count() * 1000000
+                        / std::max<std::uint64_t>(elapsed.count(), 1));
+            }
+        }
+
+    private:
+        std::vector<std::pair<std::string, function_type>> benchmarks_;
+    };
+
+    struct registrar
+    {
+        registrar(char const* const name, function_type function)
+        {
+            registry::instance().add(name, std::move(function));
+        }
+    };
+
+} // namespace benchmark
+
+#define ALLIUM_BENCHMARK(name, iterations) \
+    static void name(std::uint64_t); \
+    static ::benchmark::registrar const name ## _registrar{#name, name}; \
+    static void name(std::uint64_t const iterations)
+
+#endif // ALLIUM_BENCHMARK_BENCHMARK_HPP
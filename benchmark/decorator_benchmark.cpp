@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <utility>
+#include <canard/net/ofp/controller/decorator.hpp>
+#include <canard/net/ofp/controller/profiling_decorator.hpp>
+#include "benchmark.hpp"
+
+namespace allium = canard::net::ofp::controller;
+
+namespace {
+
+    struct message
+    {
+        auto type() const noexcept
+            -> std::uint8_t
+        {
+            return 2;
+        }
+
+        std::uint32_t xid;
+    };
+
+    template <class Base>
+    struct pass_through : Base
+    {
+        template <class Channel, class Message>
+        void handle(Channel const& channel, Message&& msg)
+        {
+            this->forward(channel, std::forward<Message>(msg));
+        }
+    };
+
+    struct plain_handler
+    {
+        template <class Channel>
+        void handle(Channel const&, message const& msg)
+        {
+            benchmark::do_not_optimize(msg.xid);
+        }
+    };
+
+    struct decorated_handler
+        : allium::decorate<
+            decorated_handler, pass_through, pass_through, pass_through
+          >
+    {
+        template <class Channel>
+        void handle(Channel const&, message const& msg)
+        {
+            benchmark::do_not_optimize(msg.xid);
+        }
+    };
+
+    struct profiled_handler
+        : allium::decorate<profiled_handler, allium::profiling_decorator>
+    {
+        template <class Channel>
+        void handle(Channel const&, message const& msg)
+        {
+            benchmark::do_not_optimize(msg.xid);
+        }
+    };
+
+    template <class Handler>
+    void run_handler(std::uint64_t const iterations)
+    {
+        Handler handler{};
+        auto const channel = 0;
+        for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+            allium::detail::handle(
+                    handler, channel, message{std::uint32_t(i)});
+        }
+    }
+
+} // unnamed namespace
+
+ALLIUM_BENCHMARK(decorator_none, iterations)
+{
+    run_handler<plain_handler>(iterations);
+}
+
+ALLIUM_BENCHMARK(decorator_three_pass_through, iterations)
+{
+    run_handler<decorated_handler>(iterations);
+}
+
+ALLIUM_BENCHMARK(decorator_profiling, iterations)
+{
+    run_handler<profiled_handler>(iterations);
+}
@@ -0,0 +1,88 @@
+#ifndef ALLIUM_BENCHMARK_FIXTURES_HPP
+#define ALLIUM_BENCHMARK_FIXTURES_HPP
+
+#include <array>
+
+// Wire format bytes of the messages and frames used by the benchmarks.
+// The frames are those a switch typically sends in packet_in.
+namespace fixtures {
+
+    // 10.0.0.1:12345 -> 10.0.0.2:80 TCP SYN
+    constexpr std::array<unsigned char, 54> tcp_syn_frame = {{
+        // ethernet
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01, 0x08, 0x00,
+        // ipv4
+        0x45, 0x00, 0x00, 0x28, 0x00, 0x01, 0x00, 0x00,
+        0x40, 0x06, 0x66, 0xcd, 0x0a, 0x00, 0x00, 0x01,
+        0x0a, 0x00, 0x00, 0x02,
+        // tcp
+        0x30, 0x39, 0x00, 0x50, 0x00, 0x00, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0xff, 0xff,
+        0x6b, 0x56, 0x00, 0x00,
+    }};
+
+    // who-has 10.0.0.2 tell 10.0.0.1
+    constexpr std::array<unsigned char, 42> arp_request_frame = {{
+        // ethernet
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01, 0x08, 0x06,
+        // arp
+        0x00, 0x01, 0x08, 0x00, 0x06, 0x04, 0x00, 0x01,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x0a, 0x00,
+        0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x0a, 0x00, 0x00, 0x02,
+    }};
+
+    constexpr std::array<unsigned char, 8> v10_echo_request = {{
+        0x01, 0x02, 0x00, 0x08, 0x00, 0x00, 0x00, 0x01,
+    }};
+
+    // buffer_id: none, in_port: 1, reason: no match, data: tcp_syn_frame
+    constexpr std::array<unsigned char, 72> v10_packet_in = {{
+        // ofp_header
+        0x01, 0x0a, 0x00, 0x48, 0x00, 0x00, 0x00, 0x00,
+        // buffer_id, total_len, in_port, reason, pad
+        0xff, 0xff, 0xff, 0xff, 0x00, 0x36, 0x00, 0x01,
+        0x00, 0x00,
+        // data
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01, 0x08, 0x00, 0x45, 0x00,
+        0x00, 0x28, 0x00, 0x01, 0x00, 0x00, 0x40, 0x06,
+        0x66, 0xcd, 0x0a, 0x00, 0x00, 0x01, 0x0a, 0x00,
+        0x00, 0x02, 0x30, 0x39, 0x00, 0x50, 0x00, 0x00,
+        0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02,
+        0xff, 0xff, 0x6b, 0x56, 0x00, 0x00,
+    }};
+
+    constexpr std::array<unsigned char, 8> v13_echo_request = {{
+        0x04, 0x02, 0x00, 0x08, 0x00, 0x00, 0x00, 0x01,
+    }};
+
+    // buffer_id: no buffer, reason: no match, match: in_port=1,
+    // data: tcp_syn_frame
+    constexpr std::array<unsigned char, 96> v13_packet_in = {{
+        // ofp_header
+        0x04, 0x0a, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00,
+        // buffer_id, total_len, reason, table_id
+        0xff, 0xff, 0xff, 0xff, 0x00, 0x36, 0x00, 0x00,
+        // cookie
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        // ofp_match with OXM_OF_IN_PORT
+        0x00, 0x01, 0x00, 0x0c, 0x80, 0x00, 0x00, 0x04,
+        0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+        // pad
+        0x00, 0x00,
+        // data
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x01, 0x08, 0x00, 0x45, 0x00,
+        0x00, 0x28, 0x00, 0x01, 0x00, 0x00, 0x40, 0x06,
+        0x66, 0xcd, 0x0a, 0x00, 0x00, 0x01, 0x0a, 0x00,
+        0x00, 0x02, 0x30, 0x39, 0x00, 0x50, 0x00, 0x00,
+        0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02,
+        0xff, 0xff, 0x6b, 0x56, 0x00, 0x00,
+    }};
+
+} // namespace fixtures
+
+#endif // ALLIUM_BENCHMARK_FIXTURES_HPP
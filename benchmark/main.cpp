@@ -0,0 +1,54 @@
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include "benchmark.hpp"
+
+namespace {
+
+    auto option_value(char const* const arg, char const* const name)
+        -> char const*
+    {
+        auto const length = std::strlen(name);
+        if (std::strncmp(arg, name, length) == 0 && arg[length] == '=') {
+            return arg + length + 1;
+        }
+        return nullptr;
+    }
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    auto options = benchmark::run_options{};
+    try {
+        for (auto i = 1; i < argc; ++i) {
+            if (auto const filter = option_value(argv[i], "--filter")) {
+                options.filter = filter;
+            }
+            else if (auto const time = option_value(argv[i], "--min-time")) {
+                options.min_time = std::chrono::milliseconds{std::stoul(time)};
+            }
+            else if (auto const n = option_value(argv[i], "--repetitions")) {
+                options.repetitions = std::stoul(n);
+            }
+            else {
+                std::cerr
+                    << "Usage: " << argv[0]
+                    << " [--filter=<substring>] [--min-time=<ms>]"
+                       " [--repetitions=<n>]" << std::endl;
+                return 1;
+            }
+        }
+    }
+    catch (std::exception const& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    if (options.repetitions == 0) {
+        options.repetitions = 1;
+    }
+
+    benchmark::registry::instance().run(options, std::cout);
+}
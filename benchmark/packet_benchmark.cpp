@@ -0,0 +1,51 @@
+#include <cstdint>
+#include <canard/packet_parser.hpp>
+#include "benchmark.hpp"
+#include "fixtures.hpp"
+
+namespace {
+
+    struct header_counter
+    {
+        template <class Header>
+        auto operator()(Header const&)
+            -> bool
+        {
+            ++*count;
+            return true;
+        }
+
+        std::uint64_t* count;
+    };
+
+    template <class Frame>
+    void for_each_header(Frame const& frame, std::uint64_t const iterations)
+    {
+        for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+            auto count = std::uint64_t{0};
+            canard::for_each_header(frame, header_counter{&count});
+            benchmark::do_not_optimize(count);
+        }
+    }
+
+} // unnamed namespace
+
+ALLIUM_BENCHMARK(packet_ether_header_tcp, iterations)
+{
+    for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+        canard::packet{fixtures::tcp_syn_frame}.ether_header(
+                [](canard::ether_header const& header) {
+            benchmark::do_not_optimize(header.destination());
+        });
+    }
+}
+
+ALLIUM_BENCHMARK(packet_for_each_header_tcp, iterations)
+{
+    for_each_header(fixtures::tcp_syn_frame, iterations);
+}
+
+ALLIUM_BENCHMARK(packet_for_each_header_arp, iterations)
+{
+    for_each_header(fixtures::arp_request_frame, iterations);
+}
@@ -0,0 +1,187 @@
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <boost/asio/io_service.hpp>
+#include <canard/net/ofp/controller/controller.hpp>
+#include <canard/net/ofp/controller/ignored_message.hpp>
+#include <canard/net/ofp/controller/v10/secure_channel.hpp>
+#include <canard/net/ofp/controller/v13/openflow_channel.hpp>
+#include <canard/net/utils/io_service_pool.hpp>
+#include "switch_emulator.hpp"
+
+namespace ofp = canard::net::ofp;
+namespace allium = ofp::controller;
+namespace v10 = ofp::v10;
+namespace v13 = ofp::v13;
+
+namespace {
+
+    // Controller run in the same process when no address is given.
+    // Answers each packet_in with a packet_out.
+    struct responder
+    {
+        using versions = std::tuple<allium::v13::version, allium::v10::version>;
+
+        template <class Channel>
+        void handle(Channel const& channel, v10::messages::packet_in pkt_in)
+        {
+            auto const in_port = pkt_in.in_port();
+            channel->async_send(v10::messages::packet_out{
+                  pkt_in.extract_frame(), in_port
+                , { v10::actions::output{v10::protocol::OFPP_ALL} }});
+        }
+
+        template <class Channel>
+        void handle(Channel const& channel, v13::messages::packet_in pkt_in)
+        {
+            auto const in_port = pkt_in.in_port();
+            channel->async_send(v13::messages::packet_out{
+                  pkt_in.extract_frame(), in_port
+                , v13::actions::output{v13::protocol::OFPP_ALL}});
+        }
+
+        template <class... Args>
+        auto handle(Args const&...)
+            -> allium::ignored_message
+        {
+            return {};
+        }
+    };
+
+    auto option_value(char const* const arg, char const* const name)
+        -> char const*
+    {
+        auto const length = std::strlen(name);
+        if (std::strncmp(arg, name, length) == 0 && arg[length] == '=') {
+            return arg + length + 1;
+        }
+        return nullptr;
+    }
+
+    void usage(char const* const program)
+    {
+        std::cerr
+            << "Usage: " << program << " [options]\n"
+               "  --address=<address>     controller to connect"
+               " (default: in-process controller)\n"
+               "  --port=<port>           controller port (default: 6653)\n"
+               "  --switches=<n>          emulated switches (default: 16)\n"
+               "  --version=<10|13>       OpenFlow version (default: 13)\n"
+               "  --window=<n>            outstanding packet_ins per switch"
+               " (default: 64)\n"
+               "  --responses=<n>         flow_mods and packet_outs per"
+               " packet_in (default: 1)\n"
+               "  --duration=<seconds>    (default: 10)\n"
+               "  --threads=<n>           emulator threads (default: 1)\n"
+               "  --controller-threads=<n>"
+               " threads of in-process controller (default: 1)"
+            << std::endl;
+    }
+
+    void report(
+              switch_emulator::statistics const& stats
+            , switch_emulator::options const& opts)
+    {
+        auto const seconds = double(opts.duration.count());
+        auto const responses = stats.latency.count();
+        std::cout
+            << "switches:        " << stats.connected
+            << "/" << opts.switches << "\n"
+            << "packet_in:       " << stats.packet_ins << "\n"
+            << "flow_mod:        " << stats.flow_mods << "\n"
+            << "packet_out:      " << stats.packet_outs << "\n"
+            << "responses/sec:   " << responses / seconds << "\n"
+            << "latency mean:    "
+            << (responses == 0 ? 0 : stats.latency.sum() / responses)
+            << " ns\n"
+            << "latency p50:     <" << stats.latency.quantile(0.50) << " ns\n"
+            << "latency p90:     <" << stats.latency.quantile(0.90) << " ns\n"
+            << "latency p99:     <" << stats.latency.quantile(0.99) << " ns\n"
+            << "latency p99.9:   <" << stats.latency.quantile(0.999) << " ns"
+            << std::endl;
+    }
+
+} // unnamed namespace
+
+int main(int argc, char* argv[])
+{
+    auto opts = switch_emulator::options{};
+    auto in_process = true;
+    auto threads = std::size_t{1};
+    auto controller_threads = std::size_t{1};
+    try {
+        for (auto i = 1; i < argc; ++i) {
+            if (auto const value = option_value(argv[i], "--address")) {
+                opts.address = value;
+                in_process = false;
+            }
+            else if (auto const value = option_value(argv[i], "--port")) {
+                opts.port = value;
+            }
+            else if (auto const value = option_value(argv[i], "--switches")) {
+                opts.switches = std::stoul(value);
+            }
+            else if (auto const value = option_value(argv[i], "--version")) {
+                opts.version = std::string{value} == "10" ? 0x01 : 0x04;
+            }
+            else if (auto const value = option_value(argv[i], "--window")) {
+                opts.window = std::stoul(value);
+            }
+            else if (auto const value = option_value(argv[i], "--responses")) {
+                opts.responses_per_packet_in = std::stoul(value);
+            }
+            else if (auto const value = option_value(argv[i], "--duration")) {
+                opts.duration = std::chrono::seconds{std::stoul(value)};
+            }
+            else if (auto const value = option_value(argv[i], "--threads")) {
+                threads = std::stoul(value);
+            }
+            else if (auto const value
+                    = option_value(argv[i], "--controller-threads")) {
+                controller_threads = std::stoul(value);
+            }
+            else {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+    }
+    catch (std::exception const& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    using controller = allium::controller<responder>;
+    auto handler = responder{};
+    auto const pool = std::make_shared<canard::net::utils::io_service_pool>(
+            controller_threads);
+    auto cont = std::unique_ptr<controller>{};
+    auto controller_thread = std::thread{};
+    try {
+        if (in_process) {
+            cont.reset(new controller{
+                controller::options{handler}
+                    .address(opts.address).port(opts.port)
+                    .io_service_pool(pool)
+            });
+            cont->listen();
+            controller_thread = std::thread{[&]{ cont->run(); }};
+        }
+
+        boost::asio::io_service io_service;
+        report(switch_emulator::run(io_service, opts, threads), opts);
+    }
+    catch (std::exception const& e) {
+        std::cerr << e.what() << std::endl;
+    }
+
+    if (cont) {
+        cont->stop();
+        controller_thread.join();
+    }
+}
@@ -0,0 +1,380 @@
+#ifndef ALLIUM_BENCHMARK_SWITCH_EMULATOR_HPP
+#define ALLIUM_BENCHMARK_SWITCH_EMULATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/system/error_code.hpp>
+#include <canard/asio/receive_buffer.hpp>
+#include <canard/net/utils/histogram.hpp>
+#include "fixtures.hpp"
+
+// Emulated datapaths which connect to a controller, perform the hello
+// handshake and keep a window of packet_in messages outstanding.
+// Each flow_mod or packet_out is taken as a response to the oldest
+// outstanding packet_in.
+namespace switch_emulator {
+
+    struct options
+    {
+        std::string address = "127.0.0.1";
+        std::string port = "6653";
+        std::size_t switches = 16;
+        std::uint8_t version = 0x04;
+        std::size_t window = 64;
+        std::size_t responses_per_packet_in = 1;
+        std::chrono::seconds duration{10};
+    };
+
+    struct statistics
+    {
+        void merge(statistics const& other)
+        {
+            connected += other.connected;
+            packet_ins += other.packet_ins;
+            flow_mods += other.flow_mods;
+            packet_outs += other.packet_outs;
+            latency.merge(other.latency);
+        }
+
+        std::size_t connected = 0;
+        std::uint64_t packet_ins = 0;
+        std::uint64_t flow_mods = 0;
+        std::uint64_t packet_outs = 0;
+        canard::net::utils::histogram_snapshot latency; // nanoseconds
+    };
+
+    namespace detail {
+
+        enum message_type : std::uint8_t
+        {
+            hello = 0,
+            echo_request = 2,
+            echo_reply = 3,
+            features_request = 5,
+            features_reply = 6,
+            packet_out = 13,
+            flow_mod = 14,
+        };
+
+        inline auto barrier_request(std::uint8_t const version)
+            -> std::uint8_t
+        {
+            return version == 0x01 ? 18 : 20;
+        }
+
+        template <class T>
+        void put(std::vector<unsigned char>& bytes, T const value)
+        {
+            for (auto i = sizeof(T); i != 0; --i) {
+                bytes.push_back(
+                        static_cast<unsigned char>(value >> (8 * (i - 1))));
+            }
+        }
+
+        inline void put_header(
+                  std::vector<unsigned char>& bytes, std::uint8_t const version
+                , std::uint8_t const type, std::uint16_t const length
+                , std::uint32_t const xid)
+        {
+            put(bytes, version);
+            put(bytes, type);
+            put(bytes, length);
+            put(bytes, xid);
+        }
+
+        inline auto get16(unsigned char const* const data)
+            -> std::uint16_t
+        {
+            return std::uint16_t((data[0] << 8) | data[1]);
+        }
+
+    } // namespace detail
+
+    class emulated_switch
+        : public std::enable_shared_from_this<emulated_switch>
+    {
+        using tcp = boost::asio::ip::tcp;
+        using clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t header_size = 8;
+
+    public:
+        emulated_switch(
+                  boost::asio::io_service& io_service
+                , std::uint64_t const dpid, options const& opts)
+            : socket_{io_service}
+            , strand_{io_service}
+            , dpid_{dpid}
+            , options_(opts)
+            , packet_in_(
+                      opts.version == 0x01
+                    ? std::vector<unsigned char>(
+                        fixtures::v10_packet_in.begin()
+                      , fixtures::v10_packet_in.end())
+                    : std::vector<unsigned char>(
+                        fixtures::v13_packet_in.begin()
+                      , fixtures::v13_packet_in.end()))
+            , xid_{0}
+            , responses_{0}
+            , is_writing_{false}
+        {
+        }
+
+        void start(tcp::resolver::iterator endpoints)
+        {
+            auto self = shared_from_this();
+            boost::asio::async_connect(
+                      socket_, endpoints
+                    , strand_.wrap([this, self](
+                            boost::system::error_code const& ec
+                          , tcp::resolver::iterator) {
+                if (ec) {
+                    return;
+                }
+                socket_.set_option(tcp::no_delay{true});
+                ++statistics_.connected;
+                send_header(detail::hello, next_xid());
+                async_read();
+            }));
+        }
+
+        void stop()
+        {
+            auto self = shared_from_this();
+            strand_.dispatch([this, self]{
+                auto ignore = boost::system::error_code{};
+                socket_.close(ignore);
+            });
+        }
+
+        // Must be called after the io_service has stopped.
+        auto get_statistics() const
+            -> statistics
+        {
+            auto stats = statistics_;
+            stats.latency = latency_.snapshot();
+            return stats;
+        }
+
+    private:
+        auto next_xid()
+            -> std::uint32_t
+        {
+            return ++xid_;
+        }
+
+        void async_read()
+        {
+            auto self = shared_from_this();
+            socket_.async_read_some(
+                      buffer_.prepare(header_size)
+                    , strand_.wrap([this, self](
+                            boost::system::error_code const& ec
+                          , std::size_t const bytes) {
+                if (ec) {
+                    return;
+                }
+                buffer_.commit(bytes);
+                while (buffer_.size() >= header_size) {
+                    auto const first = buffer_.data();
+                    auto const length = detail::get16(first + 2);
+                    if (length < header_size) {
+                        stop();
+                        return;
+                    }
+                    if (buffer_.size() < length) {
+                        break;
+                    }
+                    handle_message(first, first + length);
+                    buffer_.consume(length);
+                }
+                flush();
+                async_read();
+            }));
+        }
+
+        void handle_message(
+                unsigned char const* const first
+              , unsigned char const* const last)
+        {
+            auto const type = first[1];
+            auto const size = output_.size();
+            switch (type) {
+            case detail::hello:
+                send_packet_ins();
+                break;
+            case detail::echo_request:
+                output_.insert(output_.end(), first, last);
+                output_[size + 1] = detail::echo_reply;
+                break;
+            case detail::features_request:
+                send_features_reply(first);
+                break;
+            case detail::packet_out:
+                ++statistics_.packet_outs;
+                handle_response();
+                break;
+            case detail::flow_mod:
+                ++statistics_.flow_mods;
+                handle_response();
+                break;
+            default:
+                if (type == detail::barrier_request(options_.version)) {
+                    output_.insert(output_.end(), first, first + header_size);
+                    output_[size + 1] = type + 1; // barrier_reply
+                }
+                break;
+            }
+        }
+
+        void send_header(std::uint8_t const type, std::uint32_t const xid)
+        {
+            detail::put_header(output_, options_.version, type, header_size, xid);
+            flush();
+        }
+
+        void send_features_reply(unsigned char const* const request)
+        {
+            auto const size = output_.size();
+            output_.insert(output_.end(), request, request + header_size);
+            output_[size + 1] = detail::features_reply;
+            output_[size + 2] = 0;
+            output_[size + 3] = 32;
+            detail::put(output_, dpid_);
+            detail::put(output_, std::uint32_t{256}); // n_buffers
+            detail::put(output_, std::uint8_t{1});    // n_tables
+            detail::put(output_, std::uint8_t{0});
+            detail::put(output_, std::uint16_t{0});
+            detail::put(output_, std::uint32_t{0});   // capabilities
+            detail::put(output_, std::uint32_t{0});
+        }
+
+        void send_packet_ins()
+        {
+            while (outstanding_.size() < options_.window) {
+                auto const xid = next_xid();
+                packet_in_[4] = static_cast<unsigned char>(xid >> 24);
+                packet_in_[5] = static_cast<unsigned char>(xid >> 16);
+                packet_in_[6] = static_cast<unsigned char>(xid >> 8);
+                packet_in_[7] = static_cast<unsigned char>(xid);
+                output_.insert(
+                        output_.end(), packet_in_.begin(), packet_in_.end());
+                outstanding_.push_back(clock::now());
+                ++statistics_.packet_ins;
+            }
+        }
+
+        void handle_response()
+        {
+            if (outstanding_.empty()) {
+                return;
+            }
+            if (++responses_ < options_.responses_per_packet_in) {
+                return;
+            }
+            responses_ = 0;
+            latency_.record(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        clock::now() - outstanding_.front()).count());
+            outstanding_.pop_front();
+            send_packet_ins();
+        }
+
+        void flush()
+        {
+            if (is_writing_ || output_.empty()) {
+                return;
+            }
+            is_writing_ = true;
+            writing_.swap(output_);
+            auto self = shared_from_this();
+            boost::asio::async_write(
+                      socket_, boost::asio::buffer(writing_)
+                    , strand_.wrap([this, self](
+                            boost::system::error_code const& ec, std::size_t) {
+                is_writing_ = false;
+                writing_.clear();
+                if (!ec) {
+                    flush();
+                }
+            }));
+        }
+
+    private:
+        tcp::socket socket_;
+        boost::asio::io_service::strand strand_;
+        std::uint64_t dpid_;
+        options options_;
+        std::vector<unsigned char> packet_in_;
+        std::uint32_t xid_;
+        canard::receive_buffer buffer_;
+        std::vector<unsigned char> output_;
+        std::vector<unsigned char> writing_;
+        std::deque<clock::time_point> outstanding_;
+        std::size_t responses_;
+        canard::net::utils::histogram latency_;
+        statistics statistics_;
+        bool is_writing_;
+    };
+
+    // Runs the emulated switches on the io_service for the duration.
+    inline auto run(
+            boost::asio::io_service& io_service, options const& opts
+          , std::size_t const threads)
+        -> statistics
+    {
+        using tcp = boost::asio::ip::tcp;
+
+        tcp::resolver resolver{io_service};
+        auto const endpoints
+            = resolver.resolve(tcp::resolver::query{opts.address, opts.port});
+
+        auto switches = std::vector<std::shared_ptr<emulated_switch>>{};
+        for (auto i = std::size_t{0}; i < opts.switches; ++i) {
+            switches.push_back(
+                    std::make_shared<emulated_switch>(io_service, i + 1, opts));
+            switches.back()->start(endpoints);
+        }
+
+        boost::asio::steady_timer timer{io_service};
+        timer.expires_from_now(opts.duration);
+        timer.async_wait([&](boost::system::error_code const&) {
+            for (auto const& sw : switches) {
+                sw->stop();
+            }
+        });
+
+        auto runners = std::vector<std::thread>{};
+        for (auto i = std::size_t{1}; i < threads; ++i) {
+            runners.emplace_back([&]{ io_service.run(); });
+        }
+        io_service.run();
+        for (auto& runner : runners) {
+            runner.join();
+        }
+
+        auto total = statistics{};
+        for (auto const& sw : switches) {
+            total.merge(sw->get_statistics());
+        }
+        return total;
+    }
+
+} // namespace switch_emulator
+
+#endif // ALLIUM_BENCHMARK_SWITCH_EMULATOR_HPP
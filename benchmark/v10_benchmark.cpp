@@ -0,0 +1,109 @@
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <utility>
+#include <vector>
+#include <canard/net/ofp/controller/shared_buffer_generator.hpp>
+#include <canard/net/ofp/controller/v10/secure_channel.hpp>
+#include <canard/net/ofp/controller/with_buffer.hpp>
+#include <canard/net/ofp/v10/messages.hpp>
+#include "../examples/v10/match_creator.hpp"
+#include "benchmark.hpp"
+#include "fixtures.hpp"
+
+namespace allium = canard::net::ofp::controller;
+namespace v10 = canard::net::ofp::v10;
+
+namespace {
+
+    // Receives the messages dispatched by handle_message as
+    // secure_channel_reader does.
+    struct reader
+    {
+        template <class Channel, class Message>
+        void handle(Channel const&, Message&& msg)
+        {
+            benchmark::do_not_optimize(msg.xid());
+        }
+
+        void handle_decode_error()
+        {
+            ++decode_errors;
+        }
+
+        std::uint64_t decode_errors;
+    };
+
+    template <std::size_t N>
+    void dispatch(
+              std::array<unsigned char, N> const& bytes
+            , std::uint64_t const iterations)
+    {
+        using header_type = allium::v10::handle_message::header_type;
+        auto r = reader{0};
+        auto const channel = 0;
+        for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+            auto const first = bytes.data();
+            auto const header
+                = allium::secure_channel_detail::read<header_type>(first);
+            allium::v10::handle_message{}(
+                    &r, channel, header, first, first + header.length);
+        }
+    }
+
+    auto make_flow_add()
+        -> v10::messages::flow_add
+    {
+        return v10::messages::flow_add{
+              match_from_packet(fixtures::tcp_syn_frame, 1)
+            , 65535
+            , 0
+            , { v10::actions::output(2) }
+            , { v10::protocol::OFP_FLOW_PERMANENT
+              , v10::protocol::OFP_FLOW_PERMANENT }
+            , 0, 0xffffffff
+        };
+    }
+
+} // unnamed namespace
+
+ALLIUM_BENCHMARK(v10_dispatch_echo_request, iterations)
+{
+    dispatch(fixtures::v10_echo_request, iterations);
+}
+
+ALLIUM_BENCHMARK(v10_dispatch_packet_in, iterations)
+{
+    dispatch(fixtures::v10_packet_in, iterations);
+}
+
+ALLIUM_BENCHMARK(v10_packet_in_decode, iterations)
+{
+    auto const last = fixtures::v10_packet_in.data()
+                    + fixtures::v10_packet_in.size();
+    for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+        auto first = fixtures::v10_packet_in.data();
+        auto const pkt_in = v10::messages::packet_in::decode(first, last);
+        benchmark::do_not_optimize(pkt_in.frame());
+    }
+}
+
+ALLIUM_BENCHMARK(v10_flow_mod_encode_vector, iterations)
+{
+    auto const flow_add = make_flow_add();
+    auto buffer = std::vector<unsigned char>{};
+    for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+        auto const buffers = allium::with_buffer(flow_add, buffer).encode();
+        benchmark::do_not_optimize(buffers);
+    }
+}
+
+ALLIUM_BENCHMARK(v10_flow_mod_encode_shared_buffer, iterations)
+{
+    auto const flow_add = make_flow_add();
+    for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+        auto const buffers = allium::with_buffer(
+                flow_add, allium::shared_buffer_generator{}).encode();
+        benchmark::do_not_optimize(buffers);
+    }
+}
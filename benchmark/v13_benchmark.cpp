@@ -0,0 +1,138 @@
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <canard/net/ofp/controller/message_view.hpp>
+#include <canard/net/ofp/controller/shared_buffer_generator.hpp>
+#include <canard/net/ofp/controller/v13/openflow_channel.hpp>
+#include <canard/net/ofp/controller/with_buffer.hpp>
+#include <canard/net/ofp/v13/messages.hpp>
+#include "../examples/v13/oxm_match_creator.hpp"
+#include "benchmark.hpp"
+#include "fixtures.hpp"
+
+namespace allium = canard::net::ofp::controller;
+namespace v13 = canard::net::ofp::v13;
+
+namespace {
+
+    // Receives the messages dispatched by handle_message as
+    // secure_channel_reader does.
+    template <class DecodePolicy>
+    struct reader
+    {
+        template <class Channel, class Message>
+        void handle(Channel const&, Message&& msg)
+        {
+            auto&& decoded = allium::detail::apply_decode_policy(
+                    DecodePolicy{}, std::forward<Message>(msg));
+            benchmark::do_not_optimize(decoded.xid());
+        }
+
+        void handle_decode_error()
+        {
+            ++decode_errors;
+        }
+
+        std::uint64_t decode_errors;
+    };
+
+    template <
+          class DecodePolicy
+        , class MessageHandler = allium::v13::handle_message
+        , std::size_t N
+    >
+    void dispatch(
+              std::array<unsigned char, N> const& bytes
+            , std::uint64_t const iterations)
+    {
+        using header_type = typename MessageHandler::header_type;
+        auto r = reader<DecodePolicy>{0};
+        auto const channel = 0;
+        for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+            auto const first = bytes.data();
+            auto const header
+                = allium::secure_channel_detail::read<header_type>(first);
+            MessageHandler{}(
+                    &r, channel, header, first, first + header.length);
+        }
+    }
+
+    auto make_flow_add()
+        -> v13::messages::flow_add
+    {
+        return v13::messages::flow_add{{
+              oxm_match_from_packet(fixtures::tcp_syn_frame), 65535
+            , 0x0000000000000001
+            , v13::flow_entry::instructions_type{
+                v13::instructions::apply_actions{v13::actions::output{2}}
+              }
+        }, 0, v13::protocol::OFPFF_SEND_FLOW_REM};
+    }
+
+} // unnamed namespace
+
+ALLIUM_BENCHMARK(v13_dispatch_echo_request, iterations)
+{
+    dispatch<allium::eager_decode>(fixtures::v13_echo_request, iterations);
+}
+
+ALLIUM_BENCHMARK(v13_dispatch_packet_in, iterations)
+{
+    dispatch<allium::eager_decode>(fixtures::v13_packet_in, iterations);
+}
+
+ALLIUM_BENCHMARK(v13_dispatch_packet_in_view, iterations)
+{
+    dispatch<allium::lazy_decode>(fixtures::v13_packet_in, iterations);
+}
+
+ALLIUM_BENCHMARK(v13_dispatch_packet_in_not_in_message_list, iterations)
+{
+    using handle_message = allium::v13::basic_handle_message<
+        std::tuple<v13::messages::flow_removed>
+    >;
+    dispatch<allium::eager_decode, handle_message>(
+            fixtures::v13_packet_in, iterations);
+}
+
+ALLIUM_BENCHMARK(v13_packet_in_decode, iterations)
+{
+    auto const last = fixtures::v13_packet_in.data()
+                    + fixtures::v13_packet_in.size();
+    for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+        auto first = fixtures::v13_packet_in.data();
+        auto const pkt_in = v13::messages::packet_in::decode(first, last);
+        benchmark::do_not_optimize(pkt_in.frame());
+    }
+}
+
+ALLIUM_BENCHMARK(v13_oxm_match_from_packet, iterations)
+{
+    for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+        auto const match = oxm_match_from_packet(fixtures::tcp_syn_frame);
+        benchmark::do_not_optimize(match);
+    }
+}
+
+ALLIUM_BENCHMARK(v13_flow_mod_encode_vector, iterations)
+{
+    auto const flow_add = make_flow_add();
+    auto buffer = std::vector<unsigned char>{};
+    for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+        auto const buffers = allium::with_buffer(flow_add, buffer).encode();
+        benchmark::do_not_optimize(buffers);
+    }
+}
+
+ALLIUM_BENCHMARK(v13_flow_mod_encode_shared_buffer, iterations)
+{
+    auto const flow_add = make_flow_add();
+    for (auto i = std::uint64_t{0}; i < iterations; ++i) {
+        auto const buffers = allium::with_buffer(
+                flow_add, allium::shared_buffer_generator{}).encode();
+        benchmark::do_not_optimize(buffers);
+    }
+}
@@ -2,6 +2,7 @@
 #include <string>
 #include <tuple>
 #include <canard/net/ofp/controller/controller.hpp>
+#include <canard/net/ofp/controller/ignored_message.hpp>
 #include <canard/net/ofp/controller/v10/secure_channel.hpp>
 #include <canard/net/utils/io_service_pool.hpp>
 #include "../match_creator.hpp"
@@ -38,7 +39,7 @@ struct cbench_switch
   }
 
   template <class... Args>
-  void handle(Args const&...) {}
+  auto handle(Args const&...) -> allium::ignored_message { return {}; }
 };
 
 int main(int argc, char* argv[])
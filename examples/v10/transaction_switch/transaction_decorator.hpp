@@ -5,12 +5,10 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
-#include <mutex>
+#include <tuple>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
 #include <boost/asio/io_service.hpp>
-#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/endian/conversion.hpp>
 #include <boost/system/error_code.hpp>
@@ -18,7 +16,9 @@
 #include <canard/asio/async_result_init.hpp>
 #include <canard/asio/detail/bind_handler.hpp>
 #include <canard/net/ofp/controller/v10/secure_channel.hpp>
+#include <canard/net/utils/timer_wheel.hpp>
 #include "./message.hpp"
+#include "./transaction_table.hpp"
 
 namespace ofp = canard::net::ofp;
 
@@ -255,7 +255,7 @@ namespace decorators {
 
     struct transaction_base
     {
-      using timer_type = boost::asio::steady_timer;
+      using timer_type = canard::net::utils::wheel_timer;
 
       boost::asio::io_service::strand context;
       timer_type timer;
@@ -318,16 +318,26 @@ namespace decorators {
     using weak_transaction_base_ptr
       = std::weak_ptr<transaction_decorator_detail::transaction_base>;
 
+    // Accessed only in the strand of the channel.
     class transaction_data
     {
       friend transaction_decorator;
-      std::unordered_map<std::uint64_t, weak_transaction_base_ptr> map;
-      std::mutex mutex;
+      transaction_table<weak_transaction_base_ptr> table;
     };
 
   public:
     using channel_data = transaction_data;
 
+    // Replies and errors are dispatched even if the handler ignores them.
+    using intercepted_message_list = std::tuple<
+        ofp::v10::messages::echo_reply
+      , ofp::v10::messages::features_reply
+      , ofp::v10::messages::get_config_reply
+      , ofp::v10::messages::barrier_reply
+      , ofp::v10::messages::queue_get_config_reply
+      , ofp::v10::messages::error
+    >;
+
     using clock_type
       = transaction_decorator_detail::transaction_base::timer_type::clock_type;
     template <class Request>
@@ -432,7 +442,7 @@ namespace decorators {
     template <class Transaction, class ReceiveResponseHandler>
     static void async_wait(
           std::shared_ptr<Transaction> const& txn
-        , boost::asio::steady_timer::duration const& timeout
+        , clock_type::duration const& timeout
         , ReceiveResponseHandler&& handler)
     {
       auto ctx = txn->context;
@@ -564,14 +574,29 @@ namespace decorators {
           return;
         }
         if (auto const channel = weak_channel_ptr_.lock()) {
-          auto& data = channel->template get_data<transaction_decorator>();
-          {
-            std::lock_guard<std::mutex> lock{data.mutex};
-            data.map.erase(key_);
+          auto ctx = channel->get_context();
+          if (ctx.running_in_this_thread()) {
+            erase_expired(channel, key_);
+          }
+          else {
+            auto const key = key_;
+            ctx.post([channel, key]{ erase_expired(channel, key); });
           }
         }
       }
 
+      // A new transaction may be registered with the same key before the
+      // erasure posted from the other thread runs.
+      static void erase_expired(
+          std::shared_ptr<typename Channel::element_type> const& channel
+        , std::uint64_t const key)
+      {
+        auto& data = channel->template get_data<transaction_decorator>();
+        data.table.erase_if(key, [](weak_transaction_base_ptr const& txn) {
+            return txn.expired();
+        });
+      }
+
       transaction<Request> txn_;
       std::weak_ptr<typename Channel::element_type> weak_channel_ptr_;
       std::uint64_t key_;
@@ -597,12 +622,30 @@ namespace decorators {
         , transaction_decorator_detail::stats_type_if_any<Request>::value
         , request.xid());
       auto txn = create_transaction<Request>(channel, key);
-      auto& data = channel->template get_data<transaction_decorator>();
-      {
-        std::lock_guard<std::mutex> lock{data.mutex};
-        data.map.emplace(key, weak_transaction_base_ptr{txn});
-        return txn;
+      auto ctx = channel->get_context();
+      if (ctx.running_in_this_thread()) {
+        insert_transaction(channel, key, txn);
       }
+      else {
+        // posted before the request, so that it runs before the reply
+        auto const weak_txn = weak_transaction_base_ptr{txn};
+        ctx.post([channel, key, weak_txn]{
+            insert_transaction(channel, key, weak_txn);
+        });
+      }
+      return txn;
+    }
+
+    template <class Channel>
+    static void insert_transaction(
+          Channel const& channel, std::uint64_t const key
+        , weak_transaction_base_ptr const& txn)
+    {
+      if (txn.expired()) {
+        return; // the request has been abandoned before the insertion
+      }
+      auto& data = channel->template get_data<transaction_decorator>();
+      data.table.insert(key, txn);
     }
 
     static auto extract_transaction(
@@ -612,17 +655,9 @@ namespace decorators {
         , std::uint32_t const xid)
       -> transaction_base_ptr
     {
-      {
-        std::lock_guard<std::mutex> lock{data.mutex};
-        auto const it = data.map.find(
-            transaction_decorator_detail::to_key(msg_type, stats_type, xid));
-        if (it == data.map.end()) {
-          return {};
-        }
-        auto const txn_weak_ptr = it->second;
-        data.map.erase(it);
-        return txn_weak_ptr.lock();
-      }
+      return data.table.extract(
+          transaction_decorator_detail::to_key(msg_type, stats_type, xid)
+      ).lock();
     }
 
     template <class Channel, class Reply>
@@ -3,6 +3,7 @@
 #include <boost/asio/spawn.hpp>
 #include <boost/format.hpp>
 #include <canard/net/ofp/controller/controller.hpp>
+#include <canard/net/ofp/controller/ignored_message.hpp>
 #include <canard/net/ofp/controller/v10/secure_channel.hpp>
 #include "./transaction_decorator.hpp"
 #include "../match_creator.hpp"
@@ -108,7 +109,7 @@ struct transaction_switch
   }
 
   template <class... Args>
-  void handle(Args const&...) {}
+  auto handle(Args const&...) -> allium::ignored_message { return {}; }
 };
 
 int main()
@@ -1,8 +1,8 @@
 #include <chrono>
 #include <iostream>
 #include <boost/asio/io_service.hpp>
-#include <boost/asio/spawn.hpp>
 #include <boost/format.hpp>
+#include <canard/asio/spawn.hpp>
 #include <canard/net/ofp/controller/controller.hpp>
 #include <canard/net/ofp/controller/v13/openflow_channel.hpp>
 #include "../oxm_match_creator.hpp"
@@ -37,8 +37,7 @@ struct coroutine_handler
           }
     }, 0, protocol::OFPFF_SEND_FLOW_REM});
 
-    boost::asio::spawn(
-        channel->get_context(), [=](boost::asio::yield_context yield) {
+    canard::spawn(channel->get_context(), [=](canard::yield_context yield) {
         auto const features_txn
           = async_send_request(channel, msg::features_request{}, yield);
         auto const features_response = async_receive_response(
@@ -64,8 +63,7 @@ struct coroutine_handler
   template <class Channel>
   void handle(Channel channel, msg::packet_in pkt_in)
   {
-    boost::asio::spawn(
-        channel->get_context(), [=](boost::asio::yield_context yield) {
+    canard::spawn(channel->get_context(), [=](canard::yield_context yield) {
         channel->async_send(msg::flow_add{{
               {oxm_match_from_packet(pkt_in.frame()), 65535}
             , 0x0000000000000000
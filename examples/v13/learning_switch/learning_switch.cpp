@@ -5,13 +5,16 @@
 #include <map>
 #include <memory>
 #include <tuple>
+#include <vector>
 #include <boost/asio/io_service.hpp>
-#include <boost/asio/steady_timer.hpp>
 #include <boost/optional/optional.hpp>
+#include <boost/system/error_code.hpp>
 #include <canard/packet_parser.hpp>
 #include <canard/mac_address.hpp>
 #include <canard/net/ofp/controller/controller.hpp>
+#include <canard/net/ofp/controller/v13/flow_mod_batch_decorator.hpp>
 #include <canard/net/ofp/controller/v13/openflow_channel.hpp>
+#include <canard/net/utils/timer_wheel.hpp>
 #include "../oxm_match_creator.hpp"
 
 namespace ofp = canard::net::ofp;
@@ -71,11 +74,14 @@ public:
 
 private:
     std::map<canard::mac_address, fdb_entry> fdb_;
-    boost::optional<boost::asio::steady_timer> timer_;
+    boost::optional<canard::net::utils::wheel_timer> timer_;
 };
 
 
 class learning_switch
+    : public allium::decorate<
+        learning_switch, allium::v13::flow_mod_batch_decorator
+      >
 {
 public:
     using versions = std::tuple<allium::v13::version>;
@@ -93,8 +99,9 @@ public:
 
             if (auto const outport = fdb.get(header.destination())) {
                 flow_mod(channel, pkt_in.frame(), outport.get());
-                channel->async_send(
-                          v13::messages::packet_out{pkt_in.extract_frame()
+                batch_send(
+                          channel
+                        , v13::messages::packet_out{pkt_in.extract_frame()
                         , in_port, v13::actions::output{outport.get()}});
             }
             else {
@@ -110,8 +117,9 @@ public:
     {
         auto& fdb = channel->template get_data<learning_switch>();
         fdb.start_age_out_timer(channel->get_context(), channel);
-        channel->async_send(
-                v13::messages::flow_add{{
+        batch_send(
+                  channel
+                , v13::messages::flow_add{{
                       v13::flow_entry_id::table_miss()
                     , 0x00000000
                     , v13::flow_entry::instructions_type{
@@ -121,6 +129,13 @@ public:
                       }
                 }, 0, v13::protocol::OFPFF_SEND_FLOW_REM}
         );
+        async_commit(channel, [](
+                      boost::system::error_code const& ec
+                    , std::vector<v13::messages::error> const& errors) {
+            if (ec || !errors.empty()) {
+                std::cerr << "failed to add table-miss entry" << std::endl;
+            }
+        });
     }
 
     template <class Channel>
@@ -143,8 +158,9 @@ private:
             , Frame frame, std::uint32_t const port)
     {
         static thread_local auto cookie = std::uint64_t{0};
-        channel->async_send(
-              v13::messages::flow_add{{
+        batch_send(
+              channel
+            , v13::messages::flow_add{{
                     oxm_match_from_packet(frame), 65535
                   , cookie++
                   , v13::flow_entry::instructions_type{
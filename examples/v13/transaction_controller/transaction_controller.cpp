@@ -1,8 +1,12 @@
+#include <cstddef>
 #include <chrono>
 #include <iostream>
+#include <memory>
+#include <tuple>
 #include <boost/asio/spawn.hpp>
 #include <boost/format.hpp>
 #include <canard/net/ofp/controller/controller.hpp>
+#include <canard/net/ofp/controller/ignored_message.hpp>
 #include <canard/net/ofp/controller/v13/openflow_channel.hpp>
 #include "./transaction_decorator.hpp"
 #include "../oxm_match_creator.hpp"
@@ -70,6 +74,100 @@ struct transaction_controller
             ofp::v13::instructions::write_actions{ ofp::v13::actions::output::to_controller() }
           }
     }, 0});
+    dump_flow_stats(channel);
+    poll_stats(channel);
+  }
+
+  template <class Channel>
+  void dump_flow_stats(Channel const& channel)
+  {
+    namespace asio = boost::asio;
+    asio::spawn(channel->get_context(), [=](asio::yield_context yield) {
+        auto const txn = async_send_request(
+              channel
+            , msg::multipart::flow_stats_request{
+                ofp::v13::oxm_match{}, ofp::v13::protocol::OFPTT_ALL
+              }
+            , yield);
+
+        // the reply may be split into several fragments
+        auto num_flow_stats = std::size_t{0};
+        for (;;) {
+          auto const txn_msg
+            = async_receive_response(txn, std::chrono::seconds{5}, yield);
+          if (!txn_msg.is_reply()) {
+            std::cout
+              << "timeout or received error for flow_stats_request" << std::endl;
+            return;
+          }
+          auto const& reply = txn_msg.reply();
+          num_flow_stats += reply.body().size();
+          if (!(reply.flags() & ofp::v13::protocol::OFPMPF_REPLY_MORE)) {
+            break;
+          }
+        }
+        std::cout
+          << format{"received %|| flow stats"} % num_flow_stats << std::endl;
+    });
+  }
+
+  // The three requests are sent in one write and waited for at once.
+  template <class Channel>
+  void poll_stats(Channel const& channel)
+  {
+    namespace decorators = canard::allium::decorators;
+    auto const group = std::make_shared<decorators::transaction_group>(
+        channel->get_context().get_io_service());
+    auto const txns = send_requests(
+          group, channel
+        , msg::multipart::port_stats_request{ofp::v13::protocol::port_no::any}
+        , msg::multipart::table_stats_request{}
+        , msg::multipart::flow_stats_request{
+            ofp::v13::oxm_match{}, ofp::v13::protocol::OFPTT_ALL
+          });
+    group->async_wait(
+          std::chrono::seconds{5}
+        , [txns](boost::system::error_code const& ec) {
+        if (ec) {
+          std::cout << "timeout of stats requests" << std::endl;
+        }
+        auto const& port_stats_txn = std::get<0>(txns);
+        if (port_stats_txn->is_completed) {
+          auto const txn_msg = port_stats_txn->take_message();
+          if (txn_msg.is_reply()) {
+            std::cout
+              << format{"received %|| port stats"}
+                 % txn_msg.reply().body().size()
+              << std::endl;
+          }
+        }
+        auto const& table_stats_txn = std::get<1>(txns);
+        if (table_stats_txn->is_completed) {
+          auto const txn_msg = table_stats_txn->take_message();
+          if (txn_msg.is_reply()) {
+            std::cout
+              << format{"received %|| table stats"}
+                 % txn_msg.reply().body().size()
+              << std::endl;
+          }
+        }
+        // the fragments of the multipart reply are taken in order
+        auto const& flow_stats_txn = std::get<2>(txns);
+        auto num_flow_stats = std::size_t{0};
+        while (flow_stats_txn->is_completed) {
+          auto const txn_msg = flow_stats_txn->take_message();
+          if (!txn_msg.is_reply()) {
+            break;
+          }
+          auto const& reply = txn_msg.reply();
+          num_flow_stats += reply.body().size();
+          if (!(reply.flags() & ofp::v13::protocol::OFPMPF_REPLY_MORE)) {
+            break;
+          }
+        }
+        std::cout
+          << format{"polled %|| flow stats"} % num_flow_stats << std::endl;
+    });
   }
 
   template <class Channel>
@@ -121,7 +219,7 @@ struct transaction_controller
   }
 
   template <class... Args>
-  void handle(Args const&...) {}
+  auto handle(Args const&...) -> allium::ignored_message { return {}; }
 };
 
 int main(int argc, char const* argv[])
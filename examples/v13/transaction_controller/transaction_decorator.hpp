@@ -4,21 +4,26 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <tuple>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
+#include <vector>
+#include <boost/asio/error.hpp>
 #include <boost/asio/io_service.hpp>
-#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/endian/conversion.hpp>
 #include <boost/system/error_code.hpp>
 #include <canard/asio/asio_handler_hook_propagation.hpp>
 #include <canard/asio/async_result_init.hpp>
 #include <canard/asio/detail/bind_handler.hpp>
+#include <canard/integer_sequence.hpp>
 #include <canard/net/ofp/controller/v13/openflow_channel.hpp>
+#include <canard/net/utils/timer_wheel.hpp>
 #include "./message.hpp"
+#include "./transaction_table.hpp"
 
 namespace ofp = canard::net::ofp;
 
@@ -29,6 +34,8 @@ namespace decorators {
   template <class Base>
   class transaction_decorator;
 
+  class transaction_group;
+
   enum class message_kind { request, reply, other };
 
   template <class Message>
@@ -276,6 +283,32 @@ namespace decorators {
       static constexpr std::uint16_t value = T::multipart_type();
     };
 
+    template <class Reply>
+    auto is_more(Reply const& reply, std::true_type)
+      -> bool
+    {
+      return reply.flags() & ofp::v13::protocol::OFPMPF_REPLY_MORE;
+    }
+
+    template <class Reply>
+    auto is_more(Reply const&, std::false_type)
+      -> bool
+    {
+      return false;
+    }
+
+    // True if the reply is a multipart fragment followed by other ones.
+    template <class Reply>
+    auto is_more(Reply const& reply)
+      -> bool
+    {
+      return transaction_decorator_detail::is_more(
+            reply
+          , std::integral_constant<
+                bool, Reply::type() == ofp::v13::protocol::OFPT_MULTIPART_REPLY
+            >{});
+    }
+
     inline static auto get_multipart_type(error_msg const& error)
       -> std::uint16_t
     {
@@ -347,7 +380,7 @@ namespace decorators {
       void operator()(boost::system::error_code const& ec)
       {
         if (txn_->msg) {
-          handler_(boost::system::error_code{}, std::move(txn_->msg));
+          handler_(boost::system::error_code{}, txn_->take_message());
         }
         else {
           handler_(ec, typename Transaction::message_type{});
@@ -377,19 +410,27 @@ namespace decorators {
 
     struct transaction_base
     {
-      using timer_type = boost::asio::steady_timer;
+      using timer_type = canard::net::utils::wheel_timer;
 
       boost::asio::io_service::strand context;
       timer_type timer;
-      message_base<error_msg>* msg_ptr;
+      // Set when the last fragment of the reply or an error is received.
+      std::atomic<bool> is_completed;
+      // Notified of the completion if the request is sent as a member of
+      // a transaction_group.
+      std::weak_ptr<transaction_group> group;
+
+      virtual void push_error(error_msg&& error) = 0;
 
     protected:
       explicit transaction_base(boost::asio::io_service::strand strand)
         : context(strand)
         , timer{context.get_io_service()}
-        , msg_ptr(nullptr)
+        , is_completed(false)
       {
       }
+
+      ~transaction_base() = default;
     };
 
     template <class T, message_kind Kind = message_traits<T>::kind>
@@ -408,13 +449,35 @@ namespace decorators {
 
 
   template <class Reply>
-  class transaction
+  class transaction final
     : public transaction_decorator_detail::transaction_base
   {
   public:
     using message_type
       = typename transaction_decorator_detail::message_type<Reply>::type;
 
+    // Moves out the message to be handled and brings forward the next
+    // fragment if any, or leaves the transaction without message.
+    // Without async_receive_response, this is to be used only once
+    // is_completed is set, e.g. when the transaction_group of the
+    // transaction has completed.
+    auto take_message()
+      -> message_type
+    {
+      auto result = std::move(msg);
+      if (next_fragment != fragments.size()) {
+        msg = std::move(fragments[next_fragment++]);
+        if (next_fragment == fragments.size()) {
+          fragments.clear();
+          next_fragment = 0;
+        }
+      }
+      else {
+        msg = message_type{};
+      }
+      return result;
+    }
+
   private:
     template <class> friend class transaction_decorator;
     template <class, class>
@@ -423,11 +486,167 @@ namespace decorators {
     explicit transaction(boost::asio::io_service::strand strand)
       : transaction_base{strand}
       , msg{}
+      , next_fragment{0}
+    {
+    }
+
+    template <class ReplyMessage>
+    void push_reply(ReplyMessage&& reply)
+    {
+      if (msg) {
+        fragments.emplace_back();
+        fragments.back().reply(std::forward<ReplyMessage>(reply));
+      }
+      else {
+        msg.reply(std::forward<ReplyMessage>(reply));
+      }
+    }
+
+    void push_error(transaction_decorator_detail::error_msg&& error) override
     {
-      this->transaction_base::msg_ptr = &msg;
+      if (msg) {
+        fragments.emplace_back();
+        fragments.back().error(std::move(error));
+      }
+      else {
+        msg.error(std::move(error));
+      }
     }
 
     message_type msg;
+    std::vector<message_type> fragments;
+    std::size_t next_fragment;
+  };
+
+
+  // Transactions, possibly of many channels, waited for with a single
+  // timer. The requests are added by transaction_decorator::send_requests,
+  // and async_wait completes once all of them have received the last
+  // fragment of the reply or an error, or with timed_out when the timeout
+  // expires first. The messages are then taken from the transactions of
+  // which is_completed is set. async_wait is called once, after all the
+  // requests are added.
+  class transaction_group
+    : public std::enable_shared_from_this<transaction_group>
+  {
+    using transaction_base_ptr
+      = std::shared_ptr<transaction_decorator_detail::transaction_base>;
+    using timer_type
+      = transaction_decorator_detail::transaction_base::timer_type;
+    using wait_handler_type = void(boost::system::error_code);
+    template <class WaitHandler>
+    using async_wait_result_init = canard::async_result_init<
+      typename std::decay<WaitHandler>::type, wait_handler_type
+    >;
+
+    template <class WaitHandler>
+    struct wait_handler_adaptor
+      : canard::asio_handler_hook_propagation<
+          wait_handler_adaptor<WaitHandler>
+        >
+    {
+      template <class Handler>
+      wait_handler_adaptor(
+          Handler&& h, std::shared_ptr<transaction_group>&& group)
+        : handler_(std::forward<Handler>(h))
+        , group_(std::move(group))
+      {
+      }
+
+      void operator()(boost::system::error_code const&)
+      {
+        auto const ec = group_->take_result();
+        handler_(ec);
+      }
+
+      auto handler() noexcept
+        -> WaitHandler&
+      {
+        return handler_;
+      }
+
+      WaitHandler handler_;
+      std::shared_ptr<transaction_group> group_;
+    };
+
+  public:
+    using clock_type = timer_type::clock_type;
+
+    explicit transaction_group(boost::asio::io_service& io_service)
+      : timer_{io_service}
+      , num_pendings_{0}
+      , is_waiting_{false}
+    {
+    }
+
+    template <class WaitHandler>
+    auto async_wait(
+        clock_type::duration const& timeout, WaitHandler&& handler)
+      -> typename async_wait_result_init<WaitHandler>::result_type
+    {
+      using handler_type
+        = typename async_wait_result_init<WaitHandler>::handler_type;
+      async_wait_result_init<WaitHandler> init{
+        std::forward<WaitHandler>(handler)
+      };
+      auto wait_handler = wait_handler_adaptor<handler_type>{
+        std::move(init.handler()), shared_from_this()
+      };
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (num_pendings_ == 0) {
+          timer_.get_io_service().post(canard::detail::bind(
+                std::move(wait_handler), boost::system::error_code{}));
+        }
+        else {
+          is_waiting_ = true;
+          timer_.expires_from_now(timeout);
+          timer_.async_wait(std::move(wait_handler));
+        }
+      }
+      return init.get();
+    }
+
+  private:
+    template <class> friend class transaction_decorator;
+
+    void add(transaction_base_ptr&& txn)
+    {
+      txn->group = shared_from_this();
+      std::lock_guard<std::mutex> lock{mutex_};
+      ++num_pendings_;
+      transactions_.push_back(std::move(txn));
+    }
+
+    // Called in the strand of the channel of the completed transaction.
+    void complete_one()
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      if (--num_pendings_ == 0 && is_waiting_) {
+        timer_.cancel();
+      }
+    }
+
+    auto take_result()
+      -> boost::system::error_code
+    {
+      // the transactions are released outside the lock
+      auto transactions = std::vector<transaction_base_ptr>{};
+      std::lock_guard<std::mutex> lock{mutex_};
+      is_waiting_ = false;
+      transactions.swap(transactions_);
+      if (num_pendings_ != 0) {
+        return boost::asio::error::timed_out;
+      }
+      return boost::system::error_code{};
+    }
+
+  private:
+    std::mutex mutex_;
+    timer_type timer_;
+    std::size_t num_pendings_;
+    bool is_waiting_;
+    std::vector<transaction_base_ptr> transactions_;
   };
 
 
@@ -440,16 +659,36 @@ namespace decorators {
     using weak_transaction_base_ptr
       = std::weak_ptr<transaction_decorator_detail::transaction_base>;
 
+    // Accessed only in the strand of the channel.
     class transaction_data
     {
       friend transaction_decorator;
-      std::unordered_map<std::uint64_t, weak_transaction_base_ptr> map;
-      std::mutex mutex;
+      transaction_table<weak_transaction_base_ptr> table;
     };
 
   public:
     using channel_data = transaction_data;
 
+    // Replies and errors are dispatched even if the handler ignores them.
+    using intercepted_message_list = std::tuple<
+        ofp::v13::messages::echo_reply
+      , ofp::v13::messages::features_reply
+      , ofp::v13::messages::get_config_reply
+      , ofp::v13::messages::queue_get_config_reply
+      , ofp::v13::messages::barrier_reply
+      , ofp::v13::messages::role_reply
+      , ofp::v13::messages::get_async_reply
+      , ofp::v13::messages::error
+      , ofp::v13::messages::multipart::description_reply
+      , ofp::v13::messages::multipart::flow_stats_reply
+      , ofp::v13::messages::multipart::aggregate_stats_reply
+      , ofp::v13::messages::multipart::table_stats_reply
+      , ofp::v13::messages::multipart::port_stats_reply
+      , ofp::v13::messages::multipart::queue_stats_reply
+      , ofp::v13::messages::multipart::table_features_reply
+      , ofp::v13::messages::multipart::port_description_reply
+    >;
+
     using clock_type
       = transaction_decorator_detail::transaction_base::timer_type::clock_type;
     template <class Request>
@@ -510,6 +749,10 @@ namespace decorators {
       return init.get();
     }
 
+    // Completes with the reply or error of the request. When the reply to
+    // a multipart request is split by OFPMPF_REPLY_MORE, each call
+    // completes with the next fragment in order of arrival, up to the one
+    // without the flag or an error.
     template <class Transaction, class ReceiveResponseHandler>
     static auto async_receive_response(
           std::shared_ptr<Transaction> const& txn
@@ -550,18 +793,44 @@ namespace decorators {
       return init.get();
     }
 
+    // Sends the requests to the channel in one write as members of the
+    // group, so that e.g. port, table and flow stats of a switch are
+    // queried in a single round trip. Returns their transactions, whose
+    // messages are taken when the group completes.
+    template <class Channel, class... Requests>
+    static auto send_requests(
+          std::shared_ptr<transaction_group> const& group
+        , Channel const& channel, Requests const&... requests)
+      -> std::tuple<transaction_ptr<Requests>...>
+    {
+      auto txns = std::make_tuple(register_request(channel, requests)...);
+      add_to_group(
+          group, txns, canard::make_index_sequence<sizeof...(Requests)>{});
+      channel->async_send_all(std::tie(requests...));
+      return txns;
+    }
+
   private:
+    template <class Transactions, std::size_t... Is>
+    static void add_to_group(
+          std::shared_ptr<transaction_group> const& group
+        , Transactions const& txns, canard::index_sequence<Is...>)
+    {
+      using expand = int[];
+      (void) expand{0, (group->add(std::get<Is>(txns)), 0)...};
+    }
+
     template <class Transaction, class ReceiveResponseHandler>
     static void async_wait(
           std::shared_ptr<Transaction> const& txn
-        , boost::asio::steady_timer::duration const& timeout
+        , clock_type::duration const& timeout
         , ReceiveResponseHandler&& handler)
     {
       auto ctx = txn->context;
       if (txn->msg) {
         ctx.post(canard::detail::bind(
                 std::forward<ReceiveResponseHandler>(handler)
-              , boost::system::error_code{}, std::move(txn->msg)));
+              , boost::system::error_code{}, txn->take_message()));
       }
       else {
         txn->timer.expires_from_now(timeout);
@@ -606,19 +875,34 @@ namespace decorators {
     };
 
     template <class Reply>
-    static void set_reply(transaction_base_ptr const& txn, Reply&& reply)
+    static void set_reply(
+        transaction_base_ptr const& txn, Reply&& reply, bool const is_final)
     {
       using request_type = typename message_traits<Reply>::request_type;
-      static_cast<transaction<request_type>*>(txn.get())->msg.reply(
+      static_cast<transaction<request_type>*>(txn.get())->push_reply(
           std::forward<Reply>(reply));
+      txn->is_completed = is_final;
       txn->timer.cancel();
+      if (is_final) {
+        notify_group(txn);
+      }
     }
 
     template <class Error>
     static void set_error(transaction_base_ptr const& txn, Error&& error)
     {
-      txn->msg_ptr->error(std::forward<Error>(error));
+      txn->push_error(
+          transaction_decorator_detail::error_msg(std::forward<Error>(error)));
+      txn->is_completed = true;
       txn->timer.cancel();
+      notify_group(txn);
+    }
+
+    static void notify_group(transaction_base_ptr const& txn)
+    {
+      if (auto const group = txn->group.lock()) {
+        group->complete_one();
+      }
     }
 
 
@@ -627,13 +911,16 @@ namespace decorators {
           Channel&& channel, Reply&& reply
         , transaction_decorator_detail::is_reply)
     {
-      if (auto txn = extract_transaction_from_reply(channel, reply)) {
+      auto const is_final = !transaction_decorator_detail::is_more(reply);
+      if (auto txn = extract_transaction_from_reply(channel, reply, is_final)) {
         auto ctx = txn->context;
         if (ctx.running_in_this_thread()) {
-          set_reply(txn, std::move(reply));
+          set_reply(txn, std::move(reply), is_final);
         }
         else {
-          ctx.post([txn, reply]() mutable { set_reply(txn, std::move(reply)); });
+          ctx.post([txn, reply, is_final]() mutable {
+              set_reply(txn, std::move(reply), is_final);
+          });
         }
       }
       else {
@@ -682,18 +969,33 @@ namespace decorators {
 
       ~transaction_with_deleter()
       {
-        if (txn_.msg) {
+        if (txn_.is_completed) {
           return;
         }
         if (auto const channel = weak_channel_ptr_.lock()) {
-          auto& data = channel->template get_data<transaction_decorator>();
-          {
-            std::lock_guard<std::mutex> lock{data.mutex};
-            data.map.erase(key_);
+          auto ctx = channel->get_context();
+          if (ctx.running_in_this_thread()) {
+            erase_expired(channel, key_);
+          }
+          else {
+            auto const key = key_;
+            ctx.post([channel, key]{ erase_expired(channel, key); });
           }
         }
       }
 
+      // A new transaction may be registered with the same key before the
+      // erasure posted from the other thread runs.
+      static void erase_expired(
+          std::shared_ptr<typename Channel::element_type> const& channel
+        , std::uint64_t const key)
+      {
+        auto& data = channel->template get_data<transaction_decorator>();
+        data.table.erase_if(key, [](weak_transaction_base_ptr const& txn) {
+            return txn.expired();
+        });
+      }
+
       transaction<Request> txn_;
       std::weak_ptr<typename Channel::element_type> weak_channel_ptr_;
       std::uint64_t key_;
@@ -719,12 +1021,30 @@ namespace decorators {
         , transaction_decorator_detail::multipart_type_if_any<Request>::value
         , request.xid());
       auto txn = create_transaction<Request>(channel, key);
-      auto& data = channel->template get_data<transaction_decorator>();
-      {
-        std::lock_guard<std::mutex> lock{data.mutex};
-        data.map.emplace(key, weak_transaction_base_ptr{txn});
-        return txn;
+      auto ctx = channel->get_context();
+      if (ctx.running_in_this_thread()) {
+        insert_transaction(channel, key, txn);
+      }
+      else {
+        // posted before the request, so that it runs before the reply
+        auto const weak_txn = weak_transaction_base_ptr{txn};
+        ctx.post([channel, key, weak_txn]{
+            insert_transaction(channel, key, weak_txn);
+        });
+      }
+      return txn;
+    }
+
+    template <class Channel>
+    static void insert_transaction(
+          Channel const& channel, std::uint64_t const key
+        , weak_transaction_base_ptr const& txn)
+    {
+      if (txn.expired()) {
+        return; // the request has been abandoned before the insertion
       }
+      auto& data = channel->template get_data<transaction_decorator>();
+      data.table.insert(key, txn);
     }
 
     static auto extract_transaction(
@@ -734,30 +1054,29 @@ namespace decorators {
         , std::uint32_t const xid)
       -> transaction_base_ptr
     {
-      {
-        std::lock_guard<std::mutex> lock{data.mutex};
-        auto const it = data.map.find(
-            transaction_decorator_detail::to_key(msg_type, multipart_type, xid));
-        if (it == data.map.end()) {
-          return {};
-        }
-        auto const txn_weak_ptr = it->second;
-        data.map.erase(it);
-        return txn_weak_ptr.lock();
-      }
+      return data.table.extract(
+          transaction_decorator_detail::to_key(msg_type, multipart_type, xid)
+      ).lock();
     }
 
+    // The transaction is left registered until the last fragment of a
+    // multipart reply.
     template <class Channel, class Reply>
     static auto extract_transaction_from_reply(
-        Channel const& channel, Reply const& reply)
+        Channel const& channel, Reply const& reply, bool const is_final)
       -> transaction_base_ptr
     {
       using request_type = typename message_traits<Reply>::request_type;
       constexpr auto multipart_type
         = transaction_decorator_detail::multipart_type_if_any<request_type>::value;
-      return extract_transaction(
-            channel->template get_data<transaction_decorator>()
-          , request_type::type(), multipart_type, reply.xid());
+      auto& data = channel->template get_data<transaction_decorator>();
+      if (is_final) {
+        return extract_transaction(
+            data, request_type::type(), multipart_type, reply.xid());
+      }
+      auto const txn = data.table.find(transaction_decorator_detail::to_key(
+            request_type::type(), multipart_type, reply.xid()));
+      return txn ? txn->lock() : transaction_base_ptr{};
     }
 
     template <class Channel, class Error>
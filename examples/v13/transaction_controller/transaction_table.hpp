@@ -0,0 +1,155 @@
+#ifndef CANARD_ALLIUM_DECORATORS_TRANSACTION_TRANSACTION_TABLE_HPP
+#define CANARD_ALLIUM_DECORATORS_TRANSACTION_TRANSACTION_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace canard {
+namespace allium {
+namespace decorators {
+
+  // Open addressing table of the pending transactions of a channel keyed
+  // by the message type, multipart type and xid of the request.
+  // Collisions are resolved by linear probing and erased slots are filled
+  // by shifting back the following entries, so that neither tombstones nor
+  // nodes are allocated per request. Not thread safe; the decorator uses it
+  // only in the strand of the channel.
+  template <class T>
+  class transaction_table
+  {
+    static constexpr std::size_t min_capacity = 16;
+
+    struct slot
+    {
+      std::uint64_t key;
+      T value;
+      bool is_used;
+    };
+
+  public:
+    transaction_table()
+      : slots_(min_capacity)
+      , size_{0}
+    {
+    }
+
+    auto size() const noexcept
+      -> std::size_t
+    {
+      return size_;
+    }
+
+    void insert(std::uint64_t const key, T value)
+    {
+      if ((size_ + 1) * 2 > slots_.size()) {
+        rehash(slots_.size() * 2);
+      }
+      auto& s = slots_[find_slot(key)];
+      if (!s.is_used) {
+        s.key = key;
+        s.is_used = true;
+        ++size_;
+      }
+      s.value = std::move(value);
+    }
+
+    auto find(std::uint64_t const key) const noexcept
+      -> T const*
+    {
+      auto const& s = slots_[find_slot(key)];
+      return s.is_used ? std::addressof(s.value) : nullptr;
+    }
+
+    // Removes the entry of the key and returns its value, or T{} if absent.
+    auto extract(std::uint64_t const key)
+      -> T
+    {
+      auto const index = find_slot(key);
+      if (!slots_[index].is_used) {
+        return T{};
+      }
+      auto value = std::move(slots_[index].value);
+      erase_at(index);
+      return value;
+    }
+
+    // Removes the entry of the key if pred(value) is true.
+    template <class Predicate>
+    void erase_if(std::uint64_t const key, Predicate pred)
+    {
+      auto const index = find_slot(key);
+      if (slots_[index].is_used && pred(slots_[index].value)) {
+        erase_at(index);
+      }
+    }
+
+  private:
+    auto mask() const noexcept
+      -> std::size_t
+    {
+      return slots_.size() - 1;
+    }
+
+    auto home_of(std::uint64_t const key) const noexcept
+      -> std::size_t
+    {
+      // the xid in the low bits differs between the requests in flight
+      auto const hash = (key ^ (key >> 32)) * 0x9e3779b97f4a7c15;
+      return std::size_t(hash >> 32) & mask();
+    }
+
+    // Slot of the key, or the empty slot where the key is to be inserted.
+    auto find_slot(std::uint64_t const key) const noexcept
+      -> std::size_t
+    {
+      auto index = home_of(key);
+      while (slots_[index].is_used && slots_[index].key != key) {
+        index = (index + 1) & mask();
+      }
+      return index;
+    }
+
+    void erase_at(std::size_t index)
+    {
+      auto next = (index + 1) & mask();
+      while (slots_[next].is_used) {
+        auto const home = home_of(slots_[next].key);
+        // moves the entry back unless its home lies in (index, next]
+        if (((next - home) & mask()) >= ((next - index) & mask())) {
+          slots_[index] = std::move(slots_[next]);
+          index = next;
+        }
+        next = (next + 1) & mask();
+      }
+      slots_[index].value = T{};
+      slots_[index].is_used = false;
+      --size_;
+    }
+
+    void rehash(std::size_t const capacity)
+    {
+      auto old_slots = std::vector<slot>(capacity);
+      old_slots.swap(slots_);
+      for (auto& s : old_slots) {
+        if (s.is_used) {
+          auto& new_slot = slots_[find_slot(s.key)];
+          new_slot.key = s.key;
+          new_slot.value = std::move(s.value);
+          new_slot.is_used = true;
+        }
+      }
+    }
+
+  private:
+    std::vector<slot> slots_;
+    std::size_t size_;
+  };
+
+} // namespace decorators
+} // namespace allium
+} // namespace canard
+
+#endif // CANARD_ALLIUM_DECORATORS_TRANSACTION_TRANSACTION_TABLE_HPP
@@ -0,0 +1,404 @@
+#ifndef CANARD_ASIO_BUFFER_POOL_HPP
+#define CANARD_ASIO_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <canard/asio/shared_buffer.hpp>
+
+namespace canard {
+
+  struct buffer_pool_statistics
+  {
+    std::uint64_t hits;
+    std::uint64_t misses;
+    std::uint64_t remote_deallocations;
+  };
+
+  namespace buffer_pool_detail {
+
+    constexpr std::size_t min_block_size = 64;
+    constexpr std::size_t num_size_classes = 11; // 64 bytes ... 64 KiB
+    constexpr std::size_t max_cached_bytes_per_class = 256 * 1024;
+
+    constexpr auto block_size(std::size_t const size_class) noexcept
+      -> std::size_t
+    {
+      return min_block_size << size_class;
+    }
+
+    inline auto size_class_of(std::size_t const size) noexcept
+      -> std::size_t
+    {
+      auto size_class = std::size_t{0};
+      while (size_class < num_size_classes && block_size(size_class) < size) {
+        ++size_class;
+      }
+      return size_class;
+    }
+
+    class thread_cache;
+
+    union block_header
+    {
+      struct
+      {
+        thread_cache* owner;
+        std::size_t size_class;
+        block_header* next;
+      } data;
+      std::max_align_t align;
+    };
+
+    inline auto allocate_block(
+          thread_cache* const owner, std::size_t const size_class
+        , std::size_t const size)
+      -> block_header*
+    {
+      auto const header = static_cast<block_header*>(
+          operator new(sizeof(block_header) + size));
+      header->data.owner = owner;
+      header->data.size_class = size_class;
+      header->data.next = nullptr;
+      return header;
+    }
+
+    inline void deallocate_block(block_header* const header) noexcept
+    {
+      operator delete(static_cast<void*>(header));
+    }
+
+    class thread_cache
+    {
+    public:
+      thread_cache() noexcept
+        : ref_count_{1}
+        , orphaned_{false}
+        , remote_frees_{nullptr}
+        , hits_{0}
+        , misses_{0}
+        , remote_deallocations_{0}
+      {
+        free_lists_.fill(nullptr);
+        counts_.fill(0);
+      }
+
+      thread_cache(thread_cache const&) = delete;
+      auto operator=(thread_cache const&) -> thread_cache& = delete;
+
+      auto allocate(std::size_t const size_class)
+        -> block_header*
+      {
+        if (!free_lists_[size_class]) {
+          drain_remote_frees();
+        }
+        if (auto const header = free_lists_[size_class]) {
+          free_lists_[size_class] = header->data.next;
+          --counts_[size_class];
+          increment(hits_);
+          return header;
+        }
+        increment(misses_);
+        ref_count_.fetch_add(1, std::memory_order_relaxed);
+        return allocate_block(
+            this, size_class, block_size(size_class));
+      }
+
+      void deallocate(block_header* const header) noexcept
+      {
+        auto const size_class = header->data.size_class;
+        if (counts_[size_class] * block_size(size_class)
+            >= max_cached_bytes_per_class) {
+          deallocate_block(header);
+          ref_count_.fetch_sub(1, std::memory_order_relaxed);
+          return;
+        }
+        header->data.next = free_lists_[size_class];
+        free_lists_[size_class] = header;
+        ++counts_[size_class];
+      }
+
+      static void deallocate_remotely(block_header* const header) noexcept
+      {
+        auto const owner = header->data.owner;
+        owner->ref_count_.fetch_add(1, std::memory_order_relaxed);
+        auto head = owner->remote_frees_.load(std::memory_order_relaxed);
+        do {
+          header->data.next = head;
+        } while (!owner->remote_frees_.compare_exchange_weak(
+              head, header, std::memory_order_seq_cst));
+        if (owner->orphaned_.load(std::memory_order_seq_cst)) {
+          owner->release_remote_frees();
+        }
+        owner->release();
+      }
+
+      void orphan() noexcept
+      {
+        for (auto& head : free_lists_) {
+          release_list(head);
+          head = nullptr;
+        }
+        counts_.fill(0);
+        orphaned_.store(true, std::memory_order_seq_cst);
+        release_remote_frees();
+        release();
+      }
+
+      void add_statistics(buffer_pool_statistics& stats) const noexcept
+      {
+        stats.hits += hits_.load(std::memory_order_relaxed);
+        stats.misses += misses_.load(std::memory_order_relaxed);
+        stats.remote_deallocations
+          += remote_deallocations_.load(std::memory_order_relaxed);
+      }
+
+    private:
+      static void increment(std::atomic<std::uint64_t>& counter) noexcept
+      {
+        counter.store(
+              counter.load(std::memory_order_relaxed) + 1
+            , std::memory_order_relaxed);
+      }
+
+      void drain_remote_frees() noexcept
+      {
+        auto header
+          = remote_frees_.exchange(nullptr, std::memory_order_acquire);
+        while (header) {
+          auto const next = header->data.next;
+          increment(remote_deallocations_);
+          deallocate(header);
+          header = next;
+        }
+      }
+
+      void release_remote_frees() noexcept
+      {
+        release_list(
+            remote_frees_.exchange(nullptr, std::memory_order_seq_cst));
+      }
+
+      void release_list(block_header* header) noexcept
+      {
+        while (header) {
+          auto const next = header->data.next;
+          deallocate_block(header);
+          ref_count_.fetch_sub(1, std::memory_order_relaxed);
+          header = next;
+        }
+      }
+
+      void release() noexcept
+      {
+        if (ref_count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          delete this;
+        }
+      }
+
+    private:
+      std::atomic<std::size_t> ref_count_;
+      std::atomic<bool> orphaned_;
+      std::atomic<block_header*> remote_frees_;
+      std::array<block_header*, num_size_classes> free_lists_;
+      std::array<std::size_t, num_size_classes> counts_;
+      std::atomic<std::uint64_t> hits_;
+      std::atomic<std::uint64_t> misses_;
+      std::atomic<std::uint64_t> remote_deallocations_;
+    };
+
+    class registry
+    {
+    public:
+      static auto instance()
+        -> registry&
+      {
+        static registry reg;
+        return reg;
+      }
+
+      void add(thread_cache* const cache)
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        caches_.push_back(cache);
+      }
+
+      void remove(thread_cache* const cache)
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        cache->add_statistics(retired_);
+        caches_.erase(
+            std::remove(caches_.begin(), caches_.end(), cache), caches_.end());
+      }
+
+      void count_unowned() noexcept
+      {
+        unowned_.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      auto statistics()
+        -> buffer_pool_statistics
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto stats = retired_;
+        for (auto const cache : caches_) {
+          cache->add_statistics(stats);
+        }
+        stats.misses += unowned_.load(std::memory_order_relaxed);
+        return stats;
+      }
+
+    private:
+      registry()
+        : retired_{0, 0, 0}
+        , unowned_{0}
+      {
+      }
+
+    private:
+      std::mutex mutex_;
+      std::vector<thread_cache*> caches_;
+      buffer_pool_statistics retired_;
+      std::atomic<std::uint64_t> unowned_;
+    };
+
+    // These are trivially destructible, so that they can be checked even
+    // while other thread local objects are destroyed at thread exit.
+    inline auto current_thread_cache() noexcept
+      -> thread_cache*&
+    {
+      static thread_local thread_cache* cache = nullptr;
+      return cache;
+    }
+
+    inline auto is_thread_cache_destroyed() noexcept
+      -> bool&
+    {
+      static thread_local bool destroyed = false;
+      return destroyed;
+    }
+
+    class thread_cache_holder
+    {
+    public:
+      thread_cache_holder()
+        : cache_{new thread_cache{}}
+      {
+        registry::instance().add(cache_);
+        current_thread_cache() = cache_;
+      }
+
+      ~thread_cache_holder()
+      {
+        is_thread_cache_destroyed() = true;
+        current_thread_cache() = nullptr;
+        registry::instance().remove(cache_);
+        cache_->orphan();
+      }
+
+      thread_cache_holder(thread_cache_holder const&) = delete;
+      auto operator=(thread_cache_holder const&)
+        -> thread_cache_holder& = delete;
+
+      auto cache() const noexcept
+        -> thread_cache*
+      {
+        return cache_;
+      }
+
+    private:
+      thread_cache* cache_;
+    };
+
+    inline auto this_thread_cache()
+      -> thread_cache*
+    {
+      if (auto const cache = current_thread_cache()) {
+        return cache;
+      }
+      if (is_thread_cache_destroyed()) {
+        return nullptr;
+      }
+      static thread_local thread_cache_holder holder;
+      return holder.cache();
+    }
+
+  } // namespace buffer_pool_detail
+
+  // Size-class pool for small buffers.
+  // Each thread caches freed blocks of its own, and blocks freed by the other
+  // threads are returned to the owner thread through a lock-free list.
+  class buffer_pool
+  {
+  public:
+    static auto allocate(std::size_t const size)
+      -> void*
+    {
+      namespace detail = buffer_pool_detail;
+      auto const size_class = detail::size_class_of(size);
+      if (size_class == detail::num_size_classes) {
+        return allocate_unowned(size) + 1;
+      }
+      if (auto const cache = detail::this_thread_cache()) {
+        return cache->allocate(size_class) + 1;
+      }
+      return allocate_unowned(size) + 1;
+    }
+
+    static void deallocate(void* const pointer, std::size_t) noexcept
+    {
+      namespace detail = buffer_pool_detail;
+      auto const header = static_cast<detail::block_header*>(pointer) - 1;
+      auto const owner = header->data.owner;
+      if (!owner) {
+        detail::deallocate_block(header);
+      }
+      else if (owner == detail::current_thread_cache()) {
+        owner->deallocate(header);
+      }
+      else {
+        detail::thread_cache::deallocate_remotely(header);
+      }
+    }
+
+    static auto statistics()
+      -> buffer_pool_statistics
+    {
+      return buffer_pool_detail::registry::instance().statistics();
+    }
+
+  private:
+    static auto allocate_unowned(std::size_t const size)
+      -> buffer_pool_detail::block_header*
+    {
+      namespace detail = buffer_pool_detail;
+      detail::registry::instance().count_unowned();
+      return detail::allocate_block(nullptr, detail::num_size_classes, size);
+    }
+  };
+
+  struct buffer_pool_allocator
+  {
+    static auto allocate(std::size_t const size)
+      -> void*
+    {
+      return buffer_pool::allocate(size);
+    }
+
+    static void deallocate(void* const pointer, std::size_t const size) noexcept
+    {
+      buffer_pool::deallocate(pointer, size);
+    }
+  };
+
+  using pooled_shared_buffer
+    = basic_shared_buffer<detail::atomic_counter, buffer_pool_allocator>;
+
+} // namespace canard
+
+#endif // CANARD_ASIO_BUFFER_POOL_HPP
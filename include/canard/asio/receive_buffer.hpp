@@ -0,0 +1,99 @@
+#ifndef CANARD_ASIO_RECEIVE_BUFFER_HPP
+#define CANARD_ASIO_RECEIVE_BUFFER_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <boost/asio/buffer.hpp>
+
+namespace canard {
+
+  // Fixed-capacity receive buffer which keeps unconsumed bytes in place.
+  // Received bytes are parsed directly from data() and the remaining partial
+  // message is moved to the front only when the free space at the tail is
+  // too small to receive the rest of it.
+  // A buffer constructed with zero capacity allocates nothing.
+  class receive_buffer
+  {
+  public:
+    static constexpr std::size_t default_capacity = 32 * 1024;
+
+    explicit receive_buffer(std::size_t const capacity = default_capacity)
+      : buffer_{capacity == 0 ? nullptr : new unsigned char[capacity]}
+      , capacity_{capacity}
+      , first_{0}
+      , last_{0}
+    {
+    }
+
+    auto data() const noexcept
+      -> unsigned char const*
+    {
+      return buffer_.get() + first_;
+    }
+
+    auto size() const noexcept
+      -> std::size_t
+    {
+      return last_ - first_;
+    }
+
+    auto capacity() const noexcept
+      -> std::size_t
+    {
+      return capacity_;
+    }
+
+    auto prepare(std::size_t const least_size)
+      -> boost::asio::mutable_buffers_1
+    {
+      reserve(least_size);
+      return boost::asio::buffer(buffer_.get() + last_, capacity_ - last_);
+    }
+
+    void commit(std::size_t const size) noexcept
+    {
+      last_ += std::min(size, capacity_ - last_);
+    }
+
+    void consume(std::size_t const size) noexcept
+    {
+      first_ += std::min(size, this->size());
+      if (first_ == last_) {
+        first_ = last_ = 0;
+      }
+    }
+
+  private:
+    void reserve(std::size_t const least_size)
+    {
+      if (capacity_ - last_ >= least_size) {
+        return;
+      }
+      auto const size = this->size();
+      if (size + least_size <= capacity_) {
+        std::memmove(buffer_.get(), data(), size);
+      }
+      else {
+        auto const new_capacity = std::max(capacity_ * 2, size + least_size);
+        auto new_buffer
+          = std::unique_ptr<unsigned char[]>{new unsigned char[new_capacity]};
+        std::memcpy(new_buffer.get(), data(), size);
+        buffer_ = std::move(new_buffer);
+        capacity_ = new_capacity;
+      }
+      first_ = 0;
+      last_ = size;
+    }
+
+  private:
+    std::unique_ptr<unsigned char[]> buffer_;
+    std::size_t capacity_;
+    std::size_t first_;
+    std::size_t last_;
+  };
+
+} // namespace canard
+
+#endif // CANARD_ASIO_RECEIVE_BUFFER_HPP
@@ -0,0 +1,93 @@
+#ifndef CANARD_ASIO_RECYCLING_HANDLER_HPP
+#define CANARD_ASIO_RECYCLING_HANDLER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+#include <canard/asio/buffer_pool.hpp>
+
+namespace canard {
+
+  // Handler whose intermediate storage is allocated from buffer_pool,
+  // so that the storage freed by a completed operation is reused by the
+  // next one on the same thread. The invocation and continuation hooks
+  // are propagated to the wrapped handler, so this is meant for the
+  // internal handlers; wrapping a handler given by the user replaces its
+  // own allocation hooks. It must not wrap a strand wrapped handler, as
+  // asio allocates the storage of the rewrapped handler through the outer
+  // handler and deallocates it through the inner one. Wrap the handler
+  // before strand.wrap instead.
+  template <class Handler>
+  class recycling_handler
+  {
+  public:
+    explicit recycling_handler(Handler const& handler)
+      : handler_(handler)
+    {
+    }
+
+    explicit recycling_handler(Handler&& handler)
+      : handler_(std::move(handler))
+    {
+    }
+
+    template <class... Args>
+    void operator()(Args&&... args)
+    {
+      handler_(std::forward<Args>(args)...);
+    }
+
+    auto handler() noexcept
+      -> Handler&
+    {
+      return handler_;
+    }
+
+    friend auto asio_handler_allocate(
+        std::size_t const size, recycling_handler*)
+      -> void*
+    {
+      return buffer_pool::allocate(size);
+    }
+
+    friend void asio_handler_deallocate(
+        void* const pointer, std::size_t const size, recycling_handler*)
+    {
+      buffer_pool::deallocate(pointer, size);
+    }
+
+    friend auto asio_handler_is_continuation(recycling_handler* const h)
+      -> bool
+    {
+      using boost::asio::asio_handler_is_continuation;
+      return asio_handler_is_continuation(std::addressof(h->handler_));
+    }
+
+    template <class Function>
+    friend void asio_handler_invoke(
+        Function&& function, recycling_handler* const h)
+    {
+      using boost::asio::asio_handler_invoke;
+      asio_handler_invoke(
+          std::forward<Function>(function), std::addressof(h->handler_));
+    }
+
+  private:
+    Handler handler_;
+  };
+
+  template <class Handler>
+  auto make_recycling_handler(Handler&& handler)
+    -> recycling_handler<typename std::decay<Handler>::type>
+  {
+    return recycling_handler<typename std::decay<Handler>::type>{
+      std::forward<Handler>(handler)
+    };
+  }
+
+} // namespace canard
+
+#endif // CANARD_ASIO_RECYCLING_HANDLER_HPP
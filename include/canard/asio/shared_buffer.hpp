@@ -39,7 +39,21 @@ namespace canard {
       }
     };
 
-    template <class Counter>
+    struct new_delete_allocator
+    {
+      static auto allocate(std::size_t const size)
+        -> void*
+      {
+        return operator new(size);
+      }
+
+      static void deallocate(void* const pointer, std::size_t) noexcept
+      {
+        operator delete(pointer);
+      }
+    };
+
+    template <class Counter, class Allocator>
     class ref_count_buffer
     {
     public:
@@ -76,8 +90,9 @@ namespace canard {
       {
         if (--p->ref_count_ == 0) {
           auto const pointer = static_cast<void*>(p);
+          auto const size = sizeof(ref_count_buffer) + p->size();
           p->~ref_count_buffer();
-          operator delete(pointer);
+          Allocator::deallocate(pointer, size);
         }
       }
 
@@ -86,22 +101,27 @@ namespace canard {
       boost::asio::mutable_buffer buffer_;
     };
 
-    template <class Counter>
+    template <class Counter, class Allocator>
     static auto make_ref_count_buffer(std::size_t const size)
-      -> ref_count_buffer<Counter>*
+      -> ref_count_buffer<Counter, Allocator>*
     {
-      constexpr auto obj_size = sizeof(ref_count_buffer<Counter>);
-      auto const pointer = operator new(obj_size + size);
-      return new(pointer) ref_count_buffer<Counter>{
+      constexpr auto obj_size = sizeof(ref_count_buffer<Counter, Allocator>);
+      auto const pointer = Allocator::allocate(obj_size + size);
+      return new(pointer) ref_count_buffer<Counter, Allocator>{
         static_cast<unsigned char*>(pointer) + obj_size, size
       };
     }
 
   } // namespace detail
 
-  template <class Counter = detail::atomic_counter>
+  template <
+      class Counter = detail::atomic_counter
+    , class Allocator = detail::new_delete_allocator
+  >
   class basic_shared_buffer
   {
+    using ref_count_buffer = detail::ref_count_buffer<Counter, Allocator>;
+
   public:
     using value_type = boost::asio::mutable_buffer;
 
@@ -124,8 +144,7 @@ namespace canard {
         : ptr()
       {}
 
-      explicit const_iterator(
-          detail::ref_count_buffer<Counter> const* const ptr) noexcept
+      explicit const_iterator(ref_count_buffer const* const ptr) noexcept
         : ptr(ptr)
       {}
 
@@ -150,7 +169,7 @@ namespace canard {
         -> typename base_type::difference_type
       { return std::distance(ptr, other.ptr); }
 
-      detail::ref_count_buffer<Counter> const* ptr;
+      ref_count_buffer const* ptr;
     };
 
     basic_shared_buffer() noexcept
@@ -159,7 +178,9 @@ namespace canard {
     }
 
     explicit basic_shared_buffer(std::size_t const buffer_size)
-      : data_{detail::make_ref_count_buffer<Counter>(buffer_size), false}
+      : data_{
+          detail::make_ref_count_buffer<Counter, Allocator>(buffer_size), false
+        }
     {
     }
 
@@ -189,11 +210,13 @@ namespace canard {
 
     void resize(std::size_t const buffer_size)
     {
-      data_.reset(detail::make_ref_count_buffer<Counter>(buffer_size), false);
+      data_.reset(
+            detail::make_ref_count_buffer<Counter, Allocator>(buffer_size)
+          , false);
     }
 
   private:
-    boost::intrusive_ptr<detail::ref_count_buffer<Counter>> data_;
+    boost::intrusive_ptr<ref_count_buffer> data_;
   };
 
   using shared_buffer = basic_shared_buffer<>;
@@ -0,0 +1,102 @@
+#ifndef CANARD_ASIO_SPAWN_HPP
+#define CANARD_ASIO_SPAWN_HPP
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/coroutine/attributes.hpp>
+#include <canard/asio/stack_pool.hpp>
+
+namespace canard {
+
+  namespace spawn_detail {
+
+    inline void default_spawn_handler()
+    {
+    }
+
+    using handler_type = decltype(
+        std::declval<boost::asio::io_service::strand&>().wrap(
+          &default_spawn_handler));
+
+  } // namespace spawn_detail
+
+  // The same type as boost::asio::yield_context of the asio bundling
+  // io_service::strand.
+  using yield_context = boost::asio::basic_yield_context<
+    spawn_detail::handler_type
+  >;
+
+  namespace spawn_detail {
+
+    template <class Function>
+    struct spawn_data
+    {
+      template <class Func>
+      spawn_data(handler_type const& h, Func&& func)
+        : handler(h)
+        , function(std::forward<Func>(func))
+      {
+      }
+
+      std::weak_ptr<yield_context::callee_type> coro;
+      handler_type handler;
+      Function function;
+    };
+
+    template <class Function>
+    struct coro_entry_point
+    {
+      void operator()(yield_context::caller_type& caller)
+      {
+        auto const data = data_;
+        yield_context const yield{data->coro, caller, data->handler};
+        (data->function)(yield);
+      }
+
+      std::shared_ptr<spawn_data<Function>> data_;
+    };
+
+    template <class Function>
+    struct spawn_helper
+    {
+      void operator()()
+      {
+        auto const coro = std::make_shared<yield_context::callee_type>(
+              coro_entry_point<Function>{data_}
+            , boost::coroutines::attributes{pool_->stack_size()}
+            , pooled_stack_allocator{*pool_});
+        data_->coro = coro;
+        (*coro)();
+      }
+
+      std::shared_ptr<spawn_data<Function>> data_;
+      stack_pool* pool_;
+    };
+
+  } // namespace spawn_detail
+
+  // Starts a stackful coroutine in the strand as boost::asio::spawn does,
+  // on a stack taken from the stack_pool of the io_service. The function
+  // is called with a yield_context, which can be passed as the completion
+  // handler of asynchronous operations such as async_receive_response of
+  // the transaction decorator.
+  template <class Function>
+  void spawn(boost::asio::io_service::strand strand, Function&& function)
+  {
+    using function_type = typename std::decay<Function>::type;
+    auto& pool = boost::asio::use_service<stack_pool>(strand.get_io_service());
+    strand.dispatch(spawn_detail::spawn_helper<function_type>{
+          std::make_shared<spawn_detail::spawn_data<function_type>>(
+              strand.wrap(&spawn_detail::default_spawn_handler)
+            , std::forward<Function>(function))
+        , &pool
+    });
+  }
+
+} // namespace canard
+
+#endif // CANARD_ASIO_SPAWN_HPP
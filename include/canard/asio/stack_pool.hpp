@@ -0,0 +1,155 @@
+#ifndef CANARD_ASIO_STACK_POOL_HPP
+#define CANARD_ASIO_STACK_POOL_HPP
+
+#include <sys/mman.h>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <boost/coroutine/stack_context.hpp>
+#include <boost/coroutine/stack_traits.hpp>
+
+namespace canard {
+
+  // Per io_service cache of coroutine stacks.
+  // Obtained by boost::asio::use_service<stack_pool>(io_service).
+  // Each stack is mapped with a guard page below it, and the stack of a
+  // completed coroutine is kept for the next one instead of being
+  // unmapped, so that starting a coroutine costs neither a mmap nor the
+  // page faults of touching a fresh stack.
+  template <class = void>
+  class basic_stack_pool
+    : public boost::asio::io_service::service
+  {
+    static constexpr std::size_t max_cached_stacks = 256;
+
+  public:
+    static boost::asio::io_service::id id;
+
+    explicit basic_stack_pool(boost::asio::io_service& io_service)
+      : boost::asio::io_service::service(io_service)
+      , stack_size_(
+          round_to_page(boost::coroutines::stack_traits::default_size()))
+    {
+    }
+
+    ~basic_stack_pool()
+    {
+      for (auto const sp : stacks_) {
+        unmap(sp, stack_size_);
+      }
+    }
+
+    // Size of the pooled stacks, excluding the guard page.
+    auto stack_size() const noexcept
+      -> std::size_t
+    {
+      return stack_size_;
+    }
+
+    // Stacks larger than stack_size() are mapped for each request and
+    // are not pooled.
+    void allocate(boost::coroutines::stack_context& sctx, std::size_t size)
+    {
+      size = round_to_page(size);
+      if (size <= stack_size_) {
+        size = stack_size_;
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (!stacks_.empty()) {
+          sctx.sp = stacks_.back();
+          sctx.size = size;
+          stacks_.pop_back();
+          return;
+        }
+      }
+      sctx.sp = map(size);
+      sctx.size = size;
+    }
+
+    void deallocate(boost::coroutines::stack_context& sctx)
+    {
+      if (sctx.size == stack_size_) {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (stacks_.size() < max_cached_stacks) {
+          stacks_.push_back(sctx.sp);
+          return;
+        }
+      }
+      unmap(sctx.sp, sctx.size);
+    }
+
+  private:
+    void shutdown_service() override
+    {
+    }
+
+    static auto page_size() noexcept
+      -> std::size_t
+    {
+      return boost::coroutines::stack_traits::page_size();
+    }
+
+    static auto round_to_page(std::size_t const size) noexcept
+      -> std::size_t
+    {
+      return (size + page_size() - 1) / page_size() * page_size();
+    }
+
+    // Returns the top of the stack, as the stack grows downward.
+    static auto map(std::size_t const size)
+      -> void*
+    {
+      auto const first = ::mmap(
+            nullptr, size + page_size(), PROT_READ | PROT_WRITE
+          , MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (first == MAP_FAILED) {
+        throw std::bad_alloc{};
+      }
+      ::mprotect(first, page_size(), PROT_NONE);
+      return static_cast<char*>(first) + page_size() + size;
+    }
+
+    static void unmap(void* const sp, std::size_t const size) noexcept
+    {
+      ::munmap(static_cast<char*>(sp) - size - page_size(), size + page_size());
+    }
+
+  private:
+    std::size_t const stack_size_;
+    std::mutex mutex_;
+    std::vector<void*> stacks_;
+  };
+
+  template <class T>
+  boost::asio::io_service::id basic_stack_pool<T>::id;
+
+  using stack_pool = basic_stack_pool<>;
+
+  // StackAllocator of Boost.Coroutine which takes the stacks from a
+  // stack_pool.
+  class pooled_stack_allocator
+  {
+  public:
+    explicit pooled_stack_allocator(stack_pool& pool) noexcept
+      : pool_(&pool)
+    {
+    }
+
+    void allocate(boost::coroutines::stack_context& sctx, std::size_t size)
+    {
+      pool_->allocate(sctx, size);
+    }
+
+    void deallocate(boost::coroutines::stack_context& sctx)
+    {
+      pool_->deallocate(sctx);
+    }
+
+  private:
+    stack_pool* pool_;
+  };
+
+} // namespace canard
+
+#endif // CANARD_ASIO_STACK_POOL_HPP
@@ -0,0 +1,355 @@
+#ifndef CANARD_NETWORK_OPENFLOW_CHANNEL_METRICS_HPP
+#define CANARD_NETWORK_OPENFLOW_CHANNEL_METRICS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <canard/asio/asio_handler_hook_propagation.hpp>
+#include <canard/net/utils/histogram.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+
+  struct message_counter
+  {
+    std::uint64_t messages;
+    std::uint64_t bytes;
+  };
+
+  struct channel_metrics_snapshot
+  {
+    // Message types at or above max_message_types are counted in the last.
+    static constexpr std::size_t max_message_types = 32;
+
+    channel_metrics_snapshot() noexcept
+      : remote_endpoint{}
+      , decode_errors{0}
+      , dropped_messages{0}
+      , write_queue_depth{0}
+      , handler_time{}
+    {
+      received.fill(message_counter{0, 0});
+      sent.fill(message_counter{0, 0});
+    }
+
+    void merge(channel_metrics_snapshot const& other) noexcept
+    {
+      for (auto i = std::size_t{0}; i < max_message_types; ++i) {
+        received[i].messages += other.received[i].messages;
+        received[i].bytes += other.received[i].bytes;
+        sent[i].messages += other.sent[i].messages;
+        sent[i].bytes += other.sent[i].bytes;
+      }
+      decode_errors += other.decode_errors;
+      dropped_messages += other.dropped_messages;
+      write_queue_depth += other.write_queue_depth;
+      handler_time.merge(other.handler_time);
+    }
+
+    std::string remote_endpoint;
+    std::array<message_counter, max_message_types> received;
+    std::array<message_counter, max_message_types> sent;
+    std::uint64_t decode_errors;
+    std::uint64_t dropped_messages; // by the write backpressure
+    std::size_t write_queue_depth;
+    // nanoseconds, empty if CANARD_NET_OFP_CONTROLLER_DISABLE_PROFILING
+    // is defined
+    utils::histogram_snapshot handler_time;
+  };
+
+  struct io_service_metrics
+  {
+    channel_metrics_snapshot total;
+    std::vector<channel_metrics_snapshot> channels;
+  };
+
+  namespace detail {
+
+    // Counters of a channel.
+    // Received messages, decode errors and handler time are recorded only
+    // in the strand of the channel, so they use plain load and store.
+    class channel_metrics
+    {
+      using snapshot_type = channel_metrics_snapshot;
+
+      struct atomic_counter
+      {
+        std::atomic<std::uint64_t> messages;
+        std::atomic<std::uint64_t> bytes;
+      };
+
+    public:
+      explicit channel_metrics(std::string remote_endpoint)
+        : remote_endpoint_(std::move(remote_endpoint))
+        , decode_errors_{0}
+        , dropped_messages_{0}
+        , write_queue_depth_{0}
+      {
+        for (auto i = std::size_t{0}; i < received_.size(); ++i) {
+          received_[i].messages.store(0, std::memory_order_relaxed);
+          received_[i].bytes.store(0, std::memory_order_relaxed);
+          sent_[i].messages.store(0, std::memory_order_relaxed);
+          sent_[i].bytes.store(0, std::memory_order_relaxed);
+        }
+      }
+
+      channel_metrics(channel_metrics const&) = delete;
+      auto operator=(channel_metrics const&) -> channel_metrics& = delete;
+
+      void count_received(std::uint8_t const type, std::size_t const length)
+        noexcept
+      {
+        auto& counter = received_[index_of(type)];
+        increment(counter.messages, 1);
+        increment(counter.bytes, length);
+      }
+
+      void count_sent(std::uint8_t const type, std::size_t const length)
+        noexcept
+      {
+        auto& counter = sent_[index_of(type)];
+        counter.messages.fetch_add(1, std::memory_order_relaxed);
+        counter.bytes.fetch_add(length, std::memory_order_relaxed);
+      }
+
+      void count_decode_error() noexcept
+      {
+        increment(decode_errors_, 1);
+      }
+
+      void count_dropped(std::uint64_t const messages = 1) noexcept
+      {
+        dropped_messages_.fetch_add(messages, std::memory_order_relaxed);
+      }
+
+      void start_write() noexcept
+      {
+        write_queue_depth_.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      void complete_write() noexcept
+      {
+        write_queue_depth_.fetch_sub(1, std::memory_order_relaxed);
+      }
+
+      template <class Rep, class Period>
+      void record_handler_time(std::chrono::duration<Rep, Period> const& time)
+        noexcept
+      {
+        handler_time_.record(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+      }
+
+      auto snapshot() const
+        -> snapshot_type
+      {
+        auto snapshot = snapshot_type{};
+        snapshot.remote_endpoint = remote_endpoint_;
+        for (auto i = std::size_t{0}; i < received_.size(); ++i) {
+          snapshot.received[i] = load(received_[i]);
+          snapshot.sent[i] = load(sent_[i]);
+        }
+        snapshot.decode_errors
+          = decode_errors_.load(std::memory_order_relaxed);
+        snapshot.dropped_messages
+          = dropped_messages_.load(std::memory_order_relaxed);
+        snapshot.write_queue_depth
+          = write_queue_depth_.load(std::memory_order_relaxed);
+        snapshot.handler_time = handler_time_.snapshot();
+        return snapshot;
+      }
+
+    private:
+      static auto index_of(std::uint8_t const type) noexcept
+        -> std::size_t
+      {
+        return std::min<std::size_t>(
+            type, snapshot_type::max_message_types - 1);
+      }
+
+      static void increment(
+          std::atomic<std::uint64_t>& counter, std::uint64_t const value)
+        noexcept
+      {
+        counter.store(
+              counter.load(std::memory_order_relaxed) + value
+            , std::memory_order_relaxed);
+      }
+
+      static auto load(atomic_counter const& counter) noexcept
+        -> message_counter
+      {
+        return message_counter{
+            counter.messages.load(std::memory_order_relaxed)
+          , counter.bytes.load(std::memory_order_relaxed)
+        };
+      }
+
+    private:
+      std::string remote_endpoint_;
+      std::array<
+        atomic_counter, snapshot_type::max_message_types
+      > received_;
+      std::array<atomic_counter, snapshot_type::max_message_types> sent_;
+      std::atomic<std::uint64_t> decode_errors_;
+      std::atomic<std::uint64_t> dropped_messages_;
+      std::atomic<std::size_t> write_queue_depth_;
+      utils::histogram handler_time_;
+    };
+
+    // Write handler which keeps the write queue depth of the channel.
+    template <class WriteHandler>
+    struct write_tracking_handler
+      : canard::asio_handler_hook_propagation<
+          write_tracking_handler<WriteHandler>
+        >
+    {
+      template <class Handler>
+      write_tracking_handler(
+          std::shared_ptr<channel_metrics> metrics, Handler&& handler)
+        : metrics_(std::move(metrics))
+        , handler_(std::forward<Handler>(handler))
+      {
+        metrics_->start_write();
+      }
+
+      auto handler() noexcept
+        -> WriteHandler&
+      {
+        return handler_;
+      }
+
+      template <class... Args>
+      void operator()(Args&&... args)
+      {
+        metrics_->complete_write();
+        handler_(std::forward<Args>(args)...);
+      }
+
+      std::shared_ptr<channel_metrics> metrics_;
+      WriteHandler handler_;
+    };
+
+    template <class WriteHandler>
+    auto make_write_tracking_handler(
+        std::shared_ptr<channel_metrics> metrics, WriteHandler&& handler)
+      -> write_tracking_handler<typename std::decay<WriteHandler>::type>
+    {
+      return write_tracking_handler<typename std::decay<WriteHandler>::type>{
+        std::move(metrics), std::forward<WriteHandler>(handler)
+      };
+    }
+
+    struct sent_message_counter
+    {
+      template <class Message>
+      void operator()(Message const& msg) const
+      {
+        metrics.count_sent(msg.type(), msg.length());
+      }
+
+      channel_metrics& metrics;
+    };
+
+    // Counts the messages encoded back to back in [first, last).
+    inline void count_sent_encoded(
+          channel_metrics& metrics
+        , unsigned char const* first, unsigned char const* const last)
+      noexcept
+    {
+      while (last - first >= 4) {
+        auto const length = std::size_t((first[2] << 8) | first[3]);
+        if (length == 0) {
+          return;
+        }
+        metrics.count_sent(first[1], length);
+        first += std::min<std::size_t>(length, last - first);
+      }
+    }
+
+  } // namespace detail
+
+  // Metrics of the channels running on an io_service.
+  // Obtained by boost::asio::use_service<channel_metrics_registry>(io_service).
+  template <class = void>
+  class basic_channel_metrics_registry
+    : public boost::asio::io_service::service
+  {
+  public:
+    static boost::asio::io_service::id id;
+
+    explicit basic_channel_metrics_registry(
+        boost::asio::io_service& io_service)
+      : boost::asio::io_service::service(io_service)
+    {
+    }
+
+    void add(std::shared_ptr<detail::channel_metrics> metrics)
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      channels_.push_back(std::move(metrics));
+    }
+
+    void remove(detail::channel_metrics const* const metrics)
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      auto const it = std::find_if(
+            channels_.begin(), channels_.end()
+          , [=](std::shared_ptr<detail::channel_metrics> const& p) {
+              return p.get() == metrics;
+          });
+      if (it != channels_.end()) {
+        auto snapshot = (*it)->snapshot();
+        snapshot.write_queue_depth = 0;
+        retired_.merge(snapshot);
+        channels_.erase(it);
+      }
+    }
+
+    auto collect() const
+      -> io_service_metrics
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      auto metrics = io_service_metrics{retired_, {}};
+      metrics.channels.reserve(channels_.size());
+      for (auto const& channel : channels_) {
+        metrics.channels.push_back(channel->snapshot());
+        metrics.total.merge(metrics.channels.back());
+      }
+      return metrics;
+    }
+
+  private:
+    void shutdown_service() override
+    {
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::vector<std::shared_ptr<detail::channel_metrics>> channels_;
+    channel_metrics_snapshot retired_;
+  };
+
+  template <class T>
+  boost::asio::io_service::id basic_channel_metrics_registry<T>::id;
+
+  using channel_metrics_registry = basic_channel_metrics_registry<>;
+
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_CHANNEL_METRICS_HPP
@@ -1,19 +1,24 @@
 #ifndef CANARD_NETWORK_OPENFLOW_CONTROLLER_HPP
 #define CANARD_NETWORK_OPENFLOW_CONTROLLER_HPP
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/system/error_code.hpp>
+#include <canard/net/ofp/controller/channel_metrics.hpp>
 #include <canard/net/ofp/controller/decorator.hpp>
 #include <canard/net/ofp/controller/options.hpp>
 #include <canard/net/ofp/controller/setup_connection.hpp>
+#include <canard/net/utils/async_logger.hpp>
 #include <canard/net/utils/io_service_pool.hpp>
-
-#include <iostream>
+#include <canard/net/utils/placement_policy.hpp>
+#include <canard/net/utils/reuse_port.hpp>
+#include <canard/net/utils/work_stealing.hpp>
 
 namespace canard {
 namespace net {
@@ -32,12 +37,22 @@ namespace controller {
       : io_service_pool_(
             options.io_service_pool()
           ? options.io_service_pool()
-          : std::make_shared<utils::io_service_pool>(1))
+          : std::make_shared<utils::io_service_pool>(
+                1, 1, options.work_stealing()))
       , io_service_{options.io_service()}
-      , acceptor_{get_io_service()}
+      , acceptors_{}
       , controller_handler_{options.handler()}
       , address_(options.address())
       , port_(options.port().empty() ? "6653" : options.port())
+      , write_coalescing_(options.write_coalescing())
+      , write_backpressure_(options.write_backpressure())
+      , work_stealing_{options.work_stealing()}
+      , placement_(options.placement())
+      , logger_(
+            options.logger()
+          ? options.logger()
+          : std::make_shared<utils::async_logger>())
+      , reuse_port_{options.reuse_port()}
       , listening_mutex_{}
       , listening_{false}
     {
@@ -48,11 +63,11 @@ namespace controller {
       listen();
       auto work = utils::io_service_pool::work{*io_service_pool_};
       if (io_service_) {
-        io_service_pool_->run(false);
+        run_io_service_pool(false);
         io_service_->run();
       }
       else {
-        io_service_pool_->run(true);
+        run_io_service_pool(true);
       }
     }
 
@@ -78,7 +93,34 @@ namespace controller {
       }
     }
 
+    // Returns the metrics of the channels for each io_service of the pool.
+    auto metrics() const
+      -> std::vector<io_service_metrics>
+    {
+      auto metrics = std::vector<io_service_metrics>{};
+      metrics.reserve(io_service_pool_->io_service_count());
+      for (auto i = std::size_t{0};
+          i < io_service_pool_->io_service_count(); ++i) {
+        metrics.push_back(
+            boost::asio::use_service<channel_metrics_registry>(
+              io_service_pool_->get_io_service(i)).collect());
+      }
+      return metrics;
+    }
+
   private:
+    void run_io_service_pool(bool const block)
+    {
+      if (!work_stealing_) {
+        io_service_pool_->run(block);
+      }
+      else {
+        io_service_pool_->start(
+              block
+            , utils::work_stealing_runner{*io_service_pool_});
+      }
+    }
+
     auto get_io_service()
       -> boost::asio::io_service&
     {
@@ -88,24 +130,61 @@ namespace controller {
       return io_service_pool_->get_io_service();
     }
 
-    void async_accept()
+    auto select_io_service(std::size_t const acceptor_index)
+      -> boost::asio::io_service&
+    {
+      if (reuse_port_) {
+        return io_service_pool_->get_io_service(acceptor_index);
+      }
+      return placement_(*io_service_pool_);
+    }
+
+    void async_accept(std::size_t const acceptor_index)
     {
       using setup_connection = detail::setup_connection<ControllerHandler>;
       auto connection = std::make_shared<setup_connection>(
-          controller_handler_, io_service_pool_->get_io_service());
-      acceptor_.async_accept(
+            controller_handler_, select_io_service(acceptor_index)
+          , logger_, write_coalescing_, write_backpressure_);
+      acceptors_[acceptor_index]->async_accept(
             connection->socket(), connection->endpoint()
           , [=](boost::system::error_code const& ec) mutable {
           if (!ec) {
             connection->start_setup();
           }
           else {
-            std::cout << "accept error: " << ec.message() << std::endl;
+            logger_->error("accept error: ", ec.message());
           }
-          async_accept();
+          async_accept(acceptor_index);
       });
     }
 
+    auto open_acceptor(
+          boost::asio::io_service& io_service, tcp::endpoint const& endpoint)
+      -> bool
+    {
+      auto ec = boost::system::error_code{};
+      auto acceptor
+        = std::unique_ptr<tcp::acceptor>{new tcp::acceptor{io_service}};
+      if (acceptor->open(endpoint.protocol(), ec)) {
+        logger_->error("open error: ", ec.message());
+        return false;
+      }
+      if (reuse_port_ && acceptor->set_option(utils::reuse_port{true}, ec)) {
+        logger_->error("reuse port error: ", ec.message());
+        return false;
+      }
+      if (acceptor->bind(endpoint, ec)) {
+        logger_->error("bind error: ", ec.message());
+        return false;
+      }
+      if (acceptor->listen(tcp::acceptor::max_connections, ec)) {
+        logger_->error("listen error: ", ec.message());
+        return false;
+      }
+      acceptors_.push_back(std::move(acceptor));
+      return true;
+    }
+
     void start_listening()
     {
       auto ec = boost::system::error_code{};
@@ -113,35 +192,43 @@ namespace controller {
       auto const endpoint_iterator = resolver.resolve(
           {address_, port_, tcp::resolver::query::passive}, ec);
       if (ec) {
-        std::cout
-          << "resolve(" << address_ << ", " << port_ << ")"
-          << " error: " << ec.message() << std::endl;
+        logger_->error(
+            "resolve(", address_, ", ", port_, ") error: ", ec.message());
         return;
       }
       auto const endpoint = (*endpoint_iterator).endpoint();
-      if (acceptor_.open(endpoint.protocol(), ec)) {
-        std::cout << "open error: " << ec.message() << std::endl;
-        return;
+      if (reuse_port_) {
+        // one acceptor per io_service, and the kernel spreads connections
+        for (auto i = std::size_t{0};
+            i < io_service_pool_->io_service_count(); ++i) {
+          if (!open_acceptor(io_service_pool_->get_io_service(i), endpoint)) {
+            acceptors_.clear();
+            return;
+          }
+        }
       }
-      if (acceptor_.bind(endpoint, ec)) {
-        std::cout << "bind error: " << ec.message() << std::endl;
+      else if (!open_acceptor(get_io_service(), endpoint)) {
         return;
       }
-      if (acceptor_.listen(tcp::acceptor::max_connections, ec)) {
-        std::cout << "listen error: " << ec.message() << std::endl;
-        return;
+      for (auto i = std::size_t{0}; i < acceptors_.size(); ++i) {
+        async_accept(i);
       }
-      async_accept();
       listening_ = true;
     }
 
   private:
     std::shared_ptr<utils::io_service_pool> io_service_pool_;
     std::shared_ptr<boost::asio::io_service> io_service_;
-    tcp::acceptor acceptor_;
+    std::vector<std::unique_ptr<tcp::acceptor>> acceptors_;
     ControllerHandler& controller_handler_;
     std::string address_;
     std::string port_;
+    write_coalescing_options write_coalescing_;
+    write_backpressure_options write_backpressure_;
+    bool work_stealing_;
+    utils::placement_policy placement_;
+    std::shared_ptr<utils::async_logger> logger_;
+    bool reuse_port_;
     std::mutex listening_mutex_;
     bool listening_;
   };
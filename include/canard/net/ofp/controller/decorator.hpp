@@ -195,6 +195,17 @@ namespace controller {
       using type = Handler;
     };
 
+    // Decorator parameterized by a leading type, used through an alias
+    // template, e.g. template <class Base> using d = basic_d<T, Base>;
+    template <
+        template <class, class> class Decorator
+      , class T, class Handler, std::size_t N
+    >
+    struct handler_type<Decorator<T, decorator_detail::forwarder<Handler, N>>>
+    {
+      using type = Handler;
+    };
+
   } // namespace decorator_detail
 
   namespace detail {
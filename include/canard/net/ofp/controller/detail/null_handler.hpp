@@ -1,6 +1,9 @@
 #ifndef CANARD_NETWORK_OPENFLOW_NULL_HANDLER_HPP
 #define CANARD_NETWORK_OPENFLOW_NULL_HANDLER_HPP
 
+#include <cstddef>
+#include <canard/asio/buffer_pool.hpp>
+
 namespace canard {
 namespace net {
 namespace ofp {
@@ -14,6 +17,20 @@ namespace detail {
     void operator()(Args&&...) const
     {
     }
+
+    // The storage of the writes sent without handler is recycled as
+    // canard::recycling_handler does.
+    friend auto asio_handler_allocate(std::size_t const size, null_handler*)
+      -> void*
+    {
+      return canard::buffer_pool::allocate(size);
+    }
+
+    friend void asio_handler_deallocate(
+        void* const pointer, std::size_t const size, null_handler*)
+    {
+      canard::buffer_pool::deallocate(pointer, size);
+    }
   };
 
 } // namespace detail
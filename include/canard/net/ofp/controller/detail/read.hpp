@@ -0,0 +1,29 @@
+#ifndef CANARD_NETWORK_OPENFLOW_DETAIL_READ_HPP
+#define CANARD_NETWORK_OPENFLOW_DETAIL_READ_HPP
+
+#include <cstring>
+#include <boost/endian/conversion.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+namespace secure_channel_detail {
+
+  template <class Data>
+  auto read(unsigned char const* const src)
+    -> Data
+  {
+    auto data = Data{};
+    std::memcpy(&data, src, sizeof(data));
+    boost::endian::big_to_native_inplace(data);
+    return data;
+  }
+
+} // namespace secure_channel_detail
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_DETAIL_READ_HPP
@@ -0,0 +1,35 @@
+#ifndef CANARD_NETWORK_OPENFLOW_DETAIL_READER_ACCESS_HPP
+#define CANARD_NETWORK_OPENFLOW_DETAIL_READER_ACCESS_HPP
+
+#include <utility>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+namespace detail {
+
+  // Gives the dispatch table traits access to the reader.
+  struct reader_access
+  {
+    template <class Reader, class Channel, class Message>
+    static void handle(
+        Reader* const reader, Channel const& channel, Message&& msg)
+    {
+      reader->handle(channel, std::forward<Message>(msg));
+    }
+
+    template <class Reader>
+    static void handle_decode_error(Reader* const reader)
+    {
+      reader->handle_decode_error();
+    }
+  };
+
+} // namespace detail
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_DETAIL_READER_ACCESS_HPP
@@ -0,0 +1,278 @@
+#ifndef CANARD_NETWORK_OPENFLOW_DISPATCH_TABLE_HPP
+#define CANARD_NETWORK_OPENFLOW_DISPATCH_TABLE_HPP
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <canard/integer_sequence.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+
+  namespace dispatch_table_detail {
+
+    template <class T, class Tuple>
+    struct contains;
+
+    template <class T>
+    struct contains<T, std::tuple<>>
+      : std::false_type
+    {};
+
+    template <class T, class U, class... Us>
+    struct contains<T, std::tuple<U, Us...>>
+      : std::conditional<
+            std::is_same<T, U>::value
+          , std::true_type
+          , contains<T, std::tuple<Us...>>
+        >::type
+    {};
+
+    template <class Tuple, class T>
+    struct push_front;
+
+    template <class... Ts, class T>
+    struct push_front<std::tuple<Ts...>, T>
+    {
+      using type = std::tuple<T, Ts...>;
+    };
+
+    // Elements of Tuple which are also contained in Filter.
+    template <class Tuple, class Filter>
+    struct intersection;
+
+    template <class Filter>
+    struct intersection<std::tuple<>, Filter>
+    {
+      using type = std::tuple<>;
+    };
+
+    template <class T, class... Ts, class Filter>
+    struct intersection<std::tuple<T, Ts...>, Filter>
+    {
+      using rest = typename intersection<std::tuple<Ts...>, Filter>::type;
+      using type = typename std::conditional<
+          contains<T, Filter>::value
+        , typename push_front<rest, T>::type
+        , rest
+      >::type;
+    };
+
+    template <class Tuple, class Other>
+    struct is_subset;
+
+    template <class Other>
+    struct is_subset<std::tuple<>, Other>
+      : std::true_type
+    {};
+
+    template <class T, class... Ts, class Other>
+    struct is_subset<std::tuple<T, Ts...>, Other>
+      : std::integral_constant<
+            bool
+          , contains<T, Other>::value
+            && is_subset<std::tuple<Ts...>, Other>::value
+        >
+    {};
+
+    // The first element of MessageList whose key is Key, or void.
+    template <class Traits, std::size_t Key, class MessageList>
+    struct find_message;
+
+    template <class Traits, std::size_t Key>
+    struct find_message<Traits, Key, std::tuple<>>
+    {
+      using type = void;
+    };
+
+    template <class Traits, std::size_t Key, class Message, class... Messages>
+    struct find_message<Traits, Key, std::tuple<Message, Messages...>>
+    {
+      using type = typename std::conditional<
+          Traits::template key<Message>() == Key
+        , Message
+        , typename find_message<
+            Traits, Key, std::tuple<Messages...>
+          >::type
+      >::type;
+    };
+
+    template <class Traits, class MessageList>
+    struct max_key;
+
+    template <class Traits>
+    struct max_key<Traits, std::tuple<>>
+      : std::integral_constant<std::size_t, 0>
+    {};
+
+    template <class Traits, class Message, class... Messages>
+    struct max_key<Traits, std::tuple<Message, Messages...>>
+      : std::integral_constant<
+            std::size_t
+          , (Traits::template key<Message>()
+              > max_key<Traits, std::tuple<Messages...>>::value)
+          ? Traits::template key<Message>()
+          : max_key<Traits, std::tuple<Messages...>>::value
+        >
+    {};
+
+    template <class Traits, class Reader, class Channel>
+    using function_type = void(*)(
+          Reader*, Channel const&, typename Traits::header_type const&
+        , unsigned char const*, unsigned char const*);
+
+    template <class Traits, class Reader, class Channel>
+    void ignore(
+          Reader*, Channel const&, typename Traits::header_type const&
+        , unsigned char const*, unsigned char const*)
+    {
+    }
+
+    template <
+        class Traits, class Reader, class Channel
+      , class HandledMessage, class KnownMessage
+    >
+    struct entry
+    {
+      static constexpr function_type<Traits, Reader, Channel> value
+        = &Traits::template handle<HandledMessage, Reader, Channel>;
+    };
+
+    template <class Traits, class Reader, class Channel, class KnownMessage>
+    struct entry<Traits, Reader, Channel, void, KnownMessage>
+    {
+      static constexpr function_type<Traits, Reader, Channel> value
+        = &dispatch_table_detail::ignore<Traits, Reader, Channel>;
+    };
+
+    template <class Traits, class Reader, class Channel>
+    struct entry<Traits, Reader, Channel, void, void>
+    {
+      static constexpr function_type<Traits, Reader, Channel> value
+        = &Traits::template handle_unknown<Reader, Channel>;
+    };
+
+    template <
+        class Traits, class KnownList, class HandledList
+      , class Reader, class Channel, class Keys
+    >
+    struct table;
+
+    template <
+        class Traits, class KnownList, class HandledList
+      , class Reader, class Channel, std::size_t... Keys
+    >
+    struct table<
+        Traits, KnownList, HandledList
+      , Reader, Channel, canard::index_sequence<Keys...>
+    >
+    {
+      static constexpr function_type<Traits, Reader, Channel>
+        functions[sizeof...(Keys)] = {
+          entry<
+              Traits, Reader, Channel
+            , typename find_message<Traits, Keys, HandledList>::type
+            , typename find_message<Traits, Keys, KnownList>::type
+          >::value...
+        };
+    };
+
+    template <
+        class Traits, class KnownList, class HandledList
+      , class Reader, class Channel, std::size_t... Keys
+    >
+    constexpr function_type<Traits, Reader, Channel> table<
+        Traits, KnownList, HandledList
+      , Reader, Channel, canard::index_sequence<Keys...>
+    >::functions[sizeof...(Keys)];
+
+  } // namespace dispatch_table_detail
+
+  // Table of functions indexed by the message type, generated from
+  // the known messages. Messages in HandledList are decoded and passed to
+  // Traits::handle, the other known messages are dropped without decoding,
+  // and unknown types are passed to Traits::handle_unknown.
+  //
+  // Traits provides header_type, key<Message>() which returns the type
+  // value of the message, handle<Message, Reader, Channel> and
+  // handle_unknown<Reader, Channel>.
+  template <class Traits, class KnownList, class HandledList = KnownList>
+  class dispatch_table
+  {
+    using handled_list = typename dispatch_table_detail::intersection<
+      KnownList, HandledList
+    >::type;
+
+    static constexpr std::size_t size
+      = dispatch_table_detail::max_key<Traits, KnownList>::value + 1;
+    static_assert(size <= 256, "too large message type value for the table");
+
+  public:
+    template <class Reader, class Channel>
+    static void dispatch(
+          std::size_t const key
+        , Reader* const reader, Channel const& channel
+        , typename Traits::header_type const& header
+        , unsigned char const* const first, unsigned char const* const last)
+    {
+      if (key >= size) {
+        Traits::template handle_unknown<Reader, Channel>(
+            reader, channel, header, first, last);
+        return;
+      }
+      dispatch_table_detail::table<
+          Traits, KnownList, handled_list
+        , Reader, Channel, canard::make_index_sequence<size>
+      >::functions[key](reader, channel, header, first, last);
+    }
+  };
+
+  namespace dispatch_table_detail {
+
+    template <class Handler>
+    auto message_list_impl(Handler const&)
+      -> typename Handler::message_list;
+    template <class Handler>
+    auto message_list_impl(...)
+      -> void;
+
+    template <class Handler, class Default, class MessageList>
+    struct message_list
+    {
+      using type = MessageList;
+    };
+
+    template <class Handler, class Default>
+    struct message_list<Handler, Default, void>
+    {
+      using type = Default;
+    };
+
+  } // namespace dispatch_table_detail
+
+  namespace detail {
+
+    // Messages which the handler declares by the message_list member type,
+    // or Default if the handler does not declare it.
+    template <class Handler, class Default>
+    using message_list_t = typename dispatch_table_detail::message_list<
+        Handler, Default
+      , decltype(dispatch_table_detail::message_list_impl<Handler>(
+            std::declval<Handler>()))
+    >::type;
+
+    template <class MessageList, class... KnownLists>
+    using is_known_message_list = dispatch_table_detail::is_subset<
+      MessageList, decltype(std::tuple_cat(std::declval<KnownLists>()...))
+    >;
+
+  } // namespace detail
+
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_DISPATCH_TABLE_HPP
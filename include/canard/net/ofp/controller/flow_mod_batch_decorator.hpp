@@ -0,0 +1,326 @@
+#ifndef CANARD_NETWORK_OPENFLOW_FLOW_MOD_BATCH_DECORATOR_HPP
+#define CANARD_NETWORK_OPENFLOW_FLOW_MOD_BATCH_DECORATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <boost/asio/error.hpp>
+#include <boost/system/error_code.hpp>
+#include <canard/asio/async_result_init.hpp>
+#include <canard/asio/recycling_handler.hpp>
+#include <canard/net/ofp/controller/decorator.hpp>
+#include <canard/net/ofp/controller/goodbye.hpp>
+#include <canard/net/ofp/controller/message_view.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+
+  namespace flow_mod_batch_detail {
+
+    template <class Error>
+    struct pending_commit
+    {
+      std::uint32_t barrier_xid;
+      std::vector<std::uint32_t> xids;
+      std::vector<Error> errors;
+      std::function<void(boost::system::error_code, std::vector<Error>)>
+        handler;
+    };
+
+    // Messages batched and not yet sent, and the commits waiting for
+    // the barrier_reply. Must be used in the strand of the channel.
+    template <class Error>
+    struct batch_data
+    {
+      batch_data()
+        : bytes{}
+        , xids{}
+        , commits{}
+        , is_handling{false}
+        , is_flush_posted{false}
+      {
+      }
+
+      std::vector<unsigned char> bytes;
+      std::vector<std::uint32_t> xids;
+      std::deque<pending_commit<Error>> commits;
+      bool is_handling;
+      bool is_flush_posted;
+    };
+
+    template <class Message, bool = detail::is_message_view<Message>::value>
+    struct owned_message
+    {
+      using type = typename std::decay<Message>::type;
+    };
+
+    template <class Message>
+    struct owned_message<Message, true>
+    {
+      using type = typename std::decay<Message>::type::message_type;
+    };
+
+    struct is_barrier_reply {};
+    struct is_error {};
+    struct is_goodbye {};
+    struct is_other {};
+
+    template <class Protocol, class Message>
+    using message_kind_t = typename std::conditional<
+        std::is_same<
+          typename owned_message<Message>::type
+        , typename Protocol::barrier_reply
+        >::value
+      , is_barrier_reply
+      , typename std::conditional<
+            std::is_same<
+              typename owned_message<Message>::type
+            , typename Protocol::error
+            >::value
+          , is_error
+          , typename std::conditional<
+                std::is_same<typename std::decay<Message>::type, goodbye>::value
+              , is_goodbye
+              , is_other
+            >::type
+        >::type
+    >::type;
+
+  } // namespace flow_mod_batch_detail
+
+  // Sends the flow_mods of a channel in one buffer.
+  // batch_send encodes the message into the batch of the channel, and
+  // async_commit sends the batch followed by a barrier_request. The commit
+  // completes with the errors of the batched messages when the
+  // barrier_reply arrives. A batch not committed is sent without barrier
+  // at the end of the handler invocation for the channel. Messages batched
+  // outside a handler invocation (e.g. from a timer or another thread) are
+  // sent by a flush posted to the strand of the channel.
+  // Messages sent by async_send are not ordered with the batched ones.
+  //
+  // Protocol provides barrier_request, barrier_reply and error types.
+  template <class Protocol, class Base>
+  class basic_flow_mod_batch_decorator
+    : public Base
+  {
+    using error_type = typename Protocol::error;
+    using batch_data = flow_mod_batch_detail::batch_data<error_type>;
+    using commit_handler_type
+      = void(boost::system::error_code, std::vector<error_type>);
+    template <class CompletionHandler>
+    using async_commit_result_init = canard::async_result_init<
+        typename std::decay<CompletionHandler>::type, commit_handler_type
+    >;
+
+  public:
+    using channel_data = batch_data;
+    using intercepted_message_list = std::tuple<
+      typename Protocol::barrier_reply, error_type
+    >;
+
+    template <class Channel, class Message>
+    void handle(Channel const& channel, Message&& msg)
+    {
+      auto& data = channel->template get_data<basic_flow_mod_batch_decorator>();
+      // replies in a message_batch are handled during the handler invocation
+      // for the batch, which flushes the batch at the end
+      auto const is_nested = data.is_handling;
+      data.is_handling = true;
+      handle_impl(
+            channel, std::forward<Message>(msg)
+          , flow_mod_batch_detail::message_kind_t<Protocol, Message>{});
+      if (is_nested) {
+        return;
+      }
+      data.is_handling = false;
+      flush_batch(channel);
+    }
+
+    template <class Channel, class Message>
+    static void batch_send(Channel const& channel, Message const& msg)
+    {
+      auto ctx = channel->get_context();
+      if (!ctx.running_in_this_thread()) {
+        ctx.post(canard::make_recycling_handler([channel, msg]{
+            batch_send(channel, msg);
+        }));
+        return;
+      }
+      auto& data = channel->template get_data<basic_flow_mod_batch_decorator>();
+      data.xids.push_back(msg.xid());
+      msg.encode(data.bytes);
+      if (!data.is_handling) {
+        post_flush_batch(channel);
+      }
+    }
+
+    template <class Channel, class CompletionHandler>
+    static auto async_commit(
+        Channel const& channel, CompletionHandler&& handler)
+      -> typename async_commit_result_init<CompletionHandler>::result_type
+    {
+      async_commit_result_init<CompletionHandler> init{
+        std::forward<CompletionHandler>(handler)
+      };
+      auto ctx = channel->get_context();
+      if (ctx.running_in_this_thread()) {
+        commit(channel, std::move(init.handler()));
+      }
+      else {
+        auto commit_handler = std::move(init.handler());
+        ctx.post(canard::make_recycling_handler(
+              [channel, commit_handler]() mutable {
+                commit(channel, std::move(commit_handler));
+        }));
+      }
+      return init.get();
+    }
+
+    // Sends the batch without barrier. Must be called in the strand.
+    template <class Channel>
+    static void flush_batch(Channel const& channel)
+    {
+      auto& data = channel->template get_data<basic_flow_mod_batch_decorator>();
+      if (data.bytes.empty()) {
+        return;
+      }
+      channel->async_send_encoded(std::move(data.bytes));
+      data.bytes.clear();
+      data.xids.clear();
+    }
+
+  private:
+    // One flush sends all the messages batched before it runs.
+    template <class Channel>
+    static void post_flush_batch(Channel const& channel)
+    {
+      auto& data = channel->template get_data<basic_flow_mod_batch_decorator>();
+      if (data.is_flush_posted) {
+        return;
+      }
+      data.is_flush_posted = true;
+      channel->get_context().post(canard::make_recycling_handler([channel]{
+          channel->template get_data<basic_flow_mod_batch_decorator>()
+            .is_flush_posted = false;
+          flush_batch(channel);
+      }));
+    }
+
+    template <class Channel, class CommitHandler>
+    static void commit(Channel const& channel, CommitHandler&& handler)
+    {
+      auto& data = channel->template get_data<basic_flow_mod_batch_decorator>();
+      auto const barrier = typename Protocol::barrier_request{};
+      auto const barrier_xid = barrier.xid();
+      barrier.encode(data.bytes);
+      data.commits.push_back(flow_mod_batch_detail::pending_commit<error_type>{
+          barrier_xid, std::move(data.xids), {}
+        , std::forward<CommitHandler>(handler)
+      });
+      data.xids.clear();
+
+      channel->async_send_encoded(
+            std::move(data.bytes)
+          , channel->get_context().wrap(
+              [channel, barrier_xid](
+                  boost::system::error_code const& ec, std::size_t) {
+                if (ec) {
+                  complete(channel, barrier_xid, ec);
+                }
+          }));
+      data.bytes.clear();
+    }
+
+    template <class Channel>
+    static auto complete(
+          Channel const& channel, std::uint32_t const barrier_xid
+        , boost::system::error_code const& ec)
+      -> bool
+    {
+      auto& commits
+        = channel->template get_data<basic_flow_mod_batch_decorator>().commits;
+      auto const it = std::find_if(
+            commits.begin(), commits.end()
+          , [=](flow_mod_batch_detail::pending_commit<error_type> const& c) {
+              return c.barrier_xid == barrier_xid;
+          });
+      if (it == commits.end()) {
+        return false;
+      }
+      auto completed = std::move(*it);
+      commits.erase(it);
+      completed.handler(ec, std::move(completed.errors));
+      return true;
+    }
+
+    template <class Channel, class Reply>
+    void handle_impl(
+          Channel const& channel, Reply&& reply
+        , flow_mod_batch_detail::is_barrier_reply)
+    {
+      if (!complete(channel, reply.xid(), boost::system::error_code{})) {
+        this->forward(channel, std::forward<Reply>(reply));
+      }
+    }
+
+    template <class Channel, class Error>
+    void handle_impl(
+          Channel const& channel, Error&& error
+        , flow_mod_batch_detail::is_error)
+    {
+      auto& commits
+        = channel->template get_data<basic_flow_mod_batch_decorator>().commits;
+      auto const xid = error.xid();
+      for (auto& commit : commits) {
+        if (commit.barrier_xid == xid
+            || std::find(commit.xids.begin(), commit.xids.end(), xid)
+               != commit.xids.end()) {
+          commit.errors.push_back(detail::apply_decode_policy(
+                eager_decode{}, std::forward<Error>(error)));
+          return;
+        }
+      }
+      this->forward(channel, std::forward<Error>(error));
+    }
+
+    template <class Channel>
+    void handle_impl(
+          Channel const& channel, goodbye const& bye
+        , flow_mod_batch_detail::is_goodbye)
+    {
+      auto& data = channel->template get_data<basic_flow_mod_batch_decorator>();
+      auto commits = std::move(data.commits);
+      data.commits.clear();
+      data.bytes.clear();
+      data.xids.clear();
+      for (auto& commit : commits) {
+        commit.handler(
+              boost::asio::error::operation_aborted
+            , std::move(commit.errors));
+      }
+      this->forward(channel, bye);
+    }
+
+    template <class Channel, class Message>
+    void handle_impl(
+          Channel const& channel, Message&& msg
+        , flow_mod_batch_detail::is_other)
+    {
+      this->forward(channel, std::forward<Message>(msg));
+    }
+  };
+
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_FLOW_MOD_BATCH_DECORATOR_HPP
@@ -0,0 +1,174 @@
+#ifndef CANARD_NETWORK_OPENFLOW_IGNORED_MESSAGE_HPP
+#define CANARD_NETWORK_OPENFLOW_IGNORED_MESSAGE_HPP
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <canard/net/ofp/controller/decorator.hpp>
+#include <canard/net/ofp/controller/dispatch_table.hpp>
+#include <canard/net/ofp/controller/message_view.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+
+  // Return type of the handle overloads which ignore the message, e.g.
+  //
+  //   template <class... Args>
+  //   auto handle(Args const&...) -> ignored_message { return {}; }
+  //
+  // The messages resolved to such overloads are dropped without decoding.
+  //
+  // The decision is made by the handler alone. A decorator which consumes
+  // a message without forwarding it must list the message in its
+  // intercepted_message_list member type, otherwise the message ignored by
+  // the handler never reaches the decorator. Decorators which see every
+  // forwarded message, e.g. for logging or profiling, do not see
+  // the ignored messages either.
+  struct ignored_message {};
+
+  namespace ignored_message_detail {
+
+    template <class Handler, class Channel, class Message>
+    auto handle_result_impl(
+        Handler& handler, Channel const& channel, Message&& msg)
+      -> decltype(handler.handle(channel, std::forward<Message>(msg)));
+    auto handle_result_impl(...)
+      -> void;
+
+    template <class Handler, class Channel, class Message>
+    using is_ignored = std::is_same<
+        decltype(ignored_message_detail::handle_result_impl(
+              std::declval<Handler&>(), std::declval<Channel const&>()
+            , std::declval<Message>()))
+      , ignored_message
+    >;
+
+    // Messages of MessageList not resolved to ignored_message overloads.
+    template <
+        class Handler, class Channel, template <class> class Decoded
+      , class MessageList
+    >
+    struct handled_by;
+
+    template <class Handler, class Channel, template <class> class Decoded>
+    struct handled_by<Handler, Channel, Decoded, std::tuple<>>
+    {
+      using type = std::tuple<>;
+    };
+
+    template <
+        class Handler, class Channel, template <class> class Decoded
+      , class Message, class... Messages
+    >
+    struct handled_by<
+      Handler, Channel, Decoded, std::tuple<Message, Messages...>
+    >
+    {
+      using argument_type = decltype(detail::apply_decode_policy(
+            detail::decode_policy_t<Handler>{}
+          , std::declval<Decoded<Message>>()));
+      using rest = typename handled_by<
+        Handler, Channel, Decoded, std::tuple<Messages...>
+      >::type;
+      using type = typename std::conditional<
+          is_ignored<Handler, Channel, argument_type>::value
+        , rest
+        , typename dispatch_table_detail::push_front<rest, Message>::type
+      >::type;
+    };
+
+    template <
+        class Handler, class Channel, template <class> class Decoded
+      , class KnownList, class DeclaredList
+    >
+    struct own_message_list
+    {
+      using type = DeclaredList;
+    };
+
+    template <
+        class Handler, class Channel, template <class> class Decoded
+      , class KnownList
+    >
+    struct own_message_list<Handler, Channel, Decoded, KnownList, void>
+      : handled_by<Handler, Channel, Decoded, KnownList>
+    {};
+
+    template <class Decorator>
+    auto intercepted_message_list_impl(Decorator const&)
+      -> typename Decorator::intercepted_message_list;
+    auto intercepted_message_list_impl(...)
+      -> std::tuple<>;
+
+    template <class Decorators>
+    struct declared_message_list;
+
+    template <class... Decorators>
+    struct declared_message_list<std::tuple<Decorators...>>
+    {
+      using type = decltype(std::tuple_cat(
+          std::declval<decltype(
+            ignored_message_detail::intercepted_message_list_impl(
+              std::declval<Decorators>()))>()...));
+    };
+
+    template <class Decorators, class KnownList>
+    struct intercepted_message_list
+      : dispatch_table_detail::intersection<
+            KnownList, typename declared_message_list<Decorators>::type
+        >
+    {};
+
+    template <
+        class Handler, class Channel, class KnownList
+      , template <class> class Decoded
+    >
+    struct handled_message_list
+    {
+      using own_list = typename own_message_list<
+          Handler, Channel, Decoded, KnownList
+        , detail::message_list_t<Handler, void>
+      >::type;
+      using intercepted_list = typename intercepted_message_list<
+        typename decorator_detail::get_all_decorators<Handler>::type, KnownList
+      >::type;
+      using type = decltype(std::tuple_cat(
+          std::declval<own_list>(), std::declval<intercepted_list>()));
+    };
+
+  } // namespace ignored_message_detail
+
+  namespace detail {
+
+    // Messages which the decorators of the handler declare by the
+    // intercepted_message_list member type.
+    template <class Handler>
+    using intercepted_message_list_t
+      = typename ignored_message_detail::declared_message_list<
+          typename decorator_detail::get_all_decorators<Handler>::type
+        >::type;
+
+    // Messages of KnownList which are dispatched to the handler.
+    // These are the message_list of the handler if declared, otherwise
+    // the messages not resolved to ignored_message overloads, together with
+    // the intercepted_message_list of the decorators. Decoded<Message> is
+    // the type passed to the handler before applying the decode policy.
+    template <
+        class Handler, class Channel, class KnownList
+      , template <class> class Decoded
+    >
+    using handled_message_list_t
+      = typename ignored_message_detail::handled_message_list<
+          Handler, Channel, KnownList, Decoded
+        >::type;
+
+  } // namespace detail
+
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_IGNORED_MESSAGE_HPP
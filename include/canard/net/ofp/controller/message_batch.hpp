@@ -0,0 +1,176 @@
+#ifndef CANARD_NETWORK_OPENFLOW_MESSAGE_BATCH_HPP
+#define CANARD_NETWORK_OPENFLOW_MESSAGE_BATCH_HPP
+
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <canard/net/ofp/controller/detail/read.hpp>
+#include <canard/net/ofp/controller/detail/reader_access.hpp>
+#include <canard/net/ofp/controller/dispatch_table.hpp>
+#include <canard/net/ofp/controller/message_view.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+
+  struct single_dispatch {};
+  struct batch_dispatch {};
+
+  namespace message_batch_detail {
+
+    template <class Handler>
+    auto dispatch_policy_impl(Handler const&)
+      -> typename Handler::dispatch_policy;
+    auto dispatch_policy_impl(...)
+      -> single_dispatch;
+
+    template <class Message, bool = detail::is_message_view<Message>::value>
+    struct message_type
+    {
+      using type = typename std::decay<Message>::type;
+    };
+
+    template <class Message>
+    struct message_type<Message, true>
+    {
+      using type = typename std::decay<Message>::type::message_type;
+    };
+
+    template <class Message, class InterceptedList>
+    using is_intercepted = dispatch_table_detail::contains<
+      typename message_type<Message>::type, InterceptedList
+    >;
+
+    // Passes the messages intercepted by the decorators to the reader,
+    // which dispatches them through the decorators, and the others to
+    // the visitor.
+    template <
+        class Visitor, class DecodePolicy, class InterceptedList
+      , class Reader, class Channel
+    >
+    struct visitor_adaptor
+    {
+      template <class Message>
+      void handle(Channel const& channel, Message&& msg)
+      {
+        handle(
+              channel, std::forward<Message>(msg)
+            , is_intercepted<Message, InterceptedList>{});
+      }
+
+      template <class Message>
+      void handle(Channel const& channel, Message&& msg, std::true_type)
+      {
+        detail::reader_access::handle(
+            reader, channel, std::forward<Message>(msg));
+      }
+
+      template <class Message>
+      void handle(Channel const&, Message&& msg, std::false_type)
+      {
+        visitor(detail::apply_decode_policy(
+              DecodePolicy{}, std::forward<Message>(msg)));
+      }
+
+      // Malformed messages in a batch are counted by the reader
+      // in the same way as ones dispatched one by one.
+      void handle_decode_error()
+      {
+        detail::reader_access::handle_decode_error(reader);
+      }
+
+      Visitor& visitor;
+      Reader* reader;
+    };
+
+  } // namespace message_batch_detail
+
+  namespace detail {
+
+    template <class Handler>
+    using is_batch_dispatch_handler = std::is_same<
+        decltype(message_batch_detail::dispatch_policy_impl(
+              std::declval<Handler>()))
+      , batch_dispatch
+    >;
+
+  } // namespace detail
+
+  // Complete messages received by a single read.
+  // The messages refer to the receive buffer of the channel,
+  // so a batch is only valid during the handler invocation.
+  // The messages in InterceptedList, i.e. the intercepted_message_list of
+  // the decorators, are not visited. for_each passes them to the decorators
+  // with the channel as a message dispatched one by one, so that
+  // the decorators see the replies and errors in the batch.
+  template <
+      class MessageHandler, class Reader, class Channel
+    , class DecodePolicy = eager_decode, class InterceptedList = std::tuple<>
+  >
+  class message_batch
+  {
+    using header_type = typename MessageHandler::header_type;
+
+  public:
+    message_batch(
+          unsigned char const* const first, unsigned char const* const last
+        , std::size_t const size
+        , Reader* const reader, Channel const& channel) noexcept
+      : first_(first)
+      , last_(last)
+      , size_(size)
+      , reader_(reader)
+      , channel_(std::addressof(channel))
+    {
+    }
+
+    auto size() const noexcept
+      -> std::size_t
+    {
+      return size_;
+    }
+
+    auto empty() const noexcept
+      -> bool
+    {
+      return size_ == 0;
+    }
+
+    auto byte_length() const noexcept
+      -> std::size_t
+    {
+      return last_ - first_;
+    }
+
+    template <class Visitor>
+    void for_each(Visitor&& visitor) const
+    {
+      auto adaptor = message_batch_detail::visitor_adaptor<
+          typename std::remove_reference<Visitor>::type
+        , DecodePolicy, InterceptedList, Reader, Channel
+      >{visitor, reader_};
+      for (auto first = first_; first != last_; ) {
+        auto const header = secure_channel_detail::read<header_type>(first);
+        auto const last = first + header.length;
+        MessageHandler{}(&adaptor, *channel_, header, first, last);
+        first = last;
+      }
+    }
+
+  private:
+    unsigned char const* first_;
+    unsigned char const* last_;
+    std::size_t size_;
+    Reader* reader_;
+    Channel const* channel_;
+  };
+
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_MESSAGE_BATCH_HPP
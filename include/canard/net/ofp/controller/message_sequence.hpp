@@ -0,0 +1,132 @@
+#ifndef CANARD_NETWORK_OPENFLOW_MESSAGE_SEQUENCE_HPP
+#define CANARD_NETWORK_OPENFLOW_MESSAGE_SEQUENCE_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include <boost/fusion/adapted/std_tuple.hpp>
+#include <boost/fusion/algorithm/iteration/for_each.hpp>
+#include <boost/fusion/support/is_sequence.hpp>
+#include <canard/asio/shared_buffer.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+
+  namespace message_sequence_detail {
+
+    struct appender
+    {
+      using iterator = unsigned char*;
+      using const_iterator = unsigned char const*;
+
+      auto begin() const noexcept
+        -> unsigned char*
+      {
+        return first;
+      }
+
+      auto end() const noexcept
+        -> unsigned char*
+      {
+        return it;
+      }
+
+      void clear() noexcept
+      {
+      }
+
+      void reserve(std::size_t) noexcept
+      {
+      }
+
+      template <class Iterator>
+      void insert(unsigned char*, Iterator first, Iterator last)
+      {
+        it = std::copy(first, last, it);
+      }
+
+      unsigned char* first;
+      unsigned char* it;
+    };
+
+    struct length_accumulator
+    {
+      template <class Message>
+      void operator()(Message const& msg) const
+      {
+        length += msg.length();
+      }
+
+      std::size_t& length;
+    };
+
+    template <class Buffer>
+    struct encoder
+    {
+      template <class Message>
+      void operator()(Message const& msg) const
+      {
+        msg.encode(buffer);
+      }
+
+      Buffer& buffer;
+    };
+
+    template <class MessageSequence, class Function>
+    void for_each(MessageSequence const& msgs, Function f, std::true_type)
+    {
+      boost::fusion::for_each(msgs, f);
+    }
+
+    template <class MessageSequence, class Function>
+    void for_each(MessageSequence const& msgs, Function f, std::false_type)
+    {
+      for (auto const& msg : msgs) {
+        f(msg);
+      }
+    }
+
+    template <class MessageSequence, class Function>
+    void for_each(MessageSequence const& msgs, Function f)
+    {
+      message_sequence_detail::for_each(
+            msgs, f
+          , std::integral_constant<
+                bool
+              , boost::fusion::traits::is_sequence<MessageSequence>::value
+            >{});
+    }
+
+  } // namespace message_sequence_detail
+
+  // Encodes messages into one contiguous buffer in order.
+  // MessageSequence is either a std::tuple of messages
+  // (e.g. std::tie(flow_mod, packet_out, barrier))
+  // or a range of messages.
+  template <class SharedBuffer = canard::shared_buffer, class MessageSequence>
+  auto encode_all(MessageSequence const& msgs)
+    -> SharedBuffer
+  {
+    auto length = std::size_t{0};
+    message_sequence_detail::for_each(
+        msgs, message_sequence_detail::length_accumulator{length});
+
+    auto buffer = SharedBuffer(length);
+    auto appender = message_sequence_detail::appender{
+      buffer.data(), buffer.data()
+    };
+    message_sequence_detail::for_each(
+        msgs, message_sequence_detail::encoder<
+          message_sequence_detail::appender
+        >{appender});
+    return buffer;
+  }
+
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_MESSAGE_SEQUENCE_HPP
@@ -0,0 +1,152 @@
+#ifndef CANARD_NETWORK_OPENFLOW_MESSAGE_VIEW_HPP
+#define CANARD_NETWORK_OPENFLOW_MESSAGE_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <canard/net/ofp/controller/detail/read.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+
+  struct eager_decode {};
+  struct lazy_decode {};
+
+  // Undecoded message which refers to the receive buffer.
+  // Fields are decoded on access, and to_owned() decodes the whole message
+  // for handlers which retain it beyond the handler invocation.
+  template <class Message>
+  class basic_message_view
+  {
+  public:
+    using message_type = Message;
+
+    basic_message_view(
+        unsigned char const* const first, unsigned char const* const last)
+      noexcept
+      : first_(first)
+      , last_(last)
+    {
+    }
+
+    auto version() const noexcept
+      -> std::uint8_t
+    {
+      return first_[0];
+    }
+
+    auto type() const noexcept
+      -> std::uint8_t
+    {
+      return first_[1];
+    }
+
+    auto length() const noexcept
+      -> std::uint16_t
+    {
+      return std::uint16_t(last_ - first_);
+    }
+
+    auto xid() const noexcept
+      -> std::uint32_t
+    {
+      return field<std::uint32_t>(4);
+    }
+
+    auto data() const noexcept
+      -> unsigned char const*
+    {
+      return first_;
+    }
+
+    auto to_owned() const
+      -> message_type
+    {
+      auto first = first_;
+      return message_type::decode(first, last_);
+    }
+
+  protected:
+    template <class T>
+    auto field(std::size_t const offset) const noexcept
+      -> T
+    {
+      return secure_channel_detail::read<T>(first_ + offset);
+    }
+
+    auto begin_at(std::size_t const offset) const noexcept
+      -> unsigned char const*
+    {
+      return first_ + offset;
+    }
+
+    auto end() const noexcept
+      -> unsigned char const*
+    {
+      return last_;
+    }
+
+  private:
+    unsigned char const* first_;
+    unsigned char const* last_;
+  };
+
+  namespace message_view_detail {
+
+    template <class Message>
+    auto is_message_view_impl(basic_message_view<Message> const*)
+      -> std::true_type;
+    auto is_message_view_impl(...)
+      -> std::false_type;
+
+    template <class Handler>
+    auto decode_policy_impl(Handler const&)
+      -> typename Handler::decode_policy;
+    auto decode_policy_impl(...)
+      -> eager_decode;
+
+  } // namespace message_view_detail
+
+  namespace detail {
+
+    template <class T>
+    using is_message_view = decltype(
+        message_view_detail::is_message_view_impl(
+          static_cast<typename std::decay<T>::type const*>(nullptr)));
+
+    template <class Handler>
+    using decode_policy_t = decltype(
+        message_view_detail::decode_policy_impl(std::declval<Handler>()));
+
+    template <class Message>
+    auto apply_decode_policy(eager_decode, Message&& msg)
+      -> typename std::enable_if<
+            is_message_view<Message>::value
+          , typename std::decay<Message>::type::message_type
+         >::type
+    {
+      return msg.to_owned();
+    }
+
+    template <class DecodePolicy, class Message>
+    auto apply_decode_policy(DecodePolicy, Message&& msg)
+      -> typename std::enable_if<
+            !is_message_view<Message>::value
+          || std::is_same<DecodePolicy, lazy_decode>::value
+          , Message&&
+         >::type
+    {
+      return std::forward<Message>(msg);
+    }
+
+  } // namespace detail
+
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_MESSAGE_VIEW_HPP
@@ -1,10 +1,15 @@
 #ifndef CANARD_NETWORK_OPENFLOW_OPTIONS_HPP
 #define CANARD_NETWORK_OPENFLOW_OPTIONS_HPP
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <boost/asio/io_service.hpp>
+#include <canard/net/ofp/controller/write_backpressure.hpp>
+#include <canard/net/ofp/controller/write_coalescing.hpp>
+#include <canard/net/utils/async_logger.hpp>
 #include <canard/net/utils/io_service_pool.hpp>
+#include <canard/net/utils/placement_policy.hpp>
 
 namespace canard {
 namespace net {
@@ -18,6 +23,9 @@ namespace controller {
     explicit controller_options(ControllerHandler& handler)
       : io_service_{}
       , handler_(handler)
+      , work_stealing_{false}
+      , placement_{utils::round_robin_placement{}}
+      , reuse_port_{false}
     {
     }
 
@@ -80,12 +88,107 @@ namespace controller {
       return *this;
     }
 
+    auto write_coalescing() const
+      -> write_coalescing_options const&
+    {
+      return write_coalescing_;
+    }
+
+    auto write_coalescing(write_coalescing_options const& options)
+      -> controller_options&
+    {
+      write_coalescing_ = options;
+      return *this;
+    }
+
+    auto write_backpressure() const
+      -> write_backpressure_options const&
+    {
+      return write_backpressure_;
+    }
+
+    // Limits the bytes queued to each channel.
+    auto write_backpressure(write_backpressure_options const& options)
+      -> controller_options&
+    {
+      write_backpressure_ = options;
+      return *this;
+    }
+
+    auto work_stealing() const
+      -> bool
+    {
+      return work_stealing_;
+    }
+
+    // Lets idle threads of the io_service_pool run ready handlers of the
+    // other io_services. The io_service_pool must be constructed with
+    // work_stealing enabled. Disabled by default.
+    auto work_stealing(bool const enabled)
+      -> controller_options&
+    {
+      work_stealing_ = enabled;
+      return *this;
+    }
+
+    auto placement() const
+      -> utils::placement_policy const&
+    {
+      return placement_;
+    }
+
+    // Selects the io_service of each accepted connection.
+    // e.g. utils::least_connections_placement{}
+    auto placement(utils::placement_policy policy)
+      -> controller_options&
+    {
+      placement_ = std::move(policy);
+      return *this;
+    }
+
+    auto logger() const
+      -> std::shared_ptr<utils::async_logger>
+    {
+      return logger_;
+    }
+
+    // Receives the diagnostics of the controller and its channels.
+    // If not set, the controller logs to std::clog.
+    auto logger(std::shared_ptr<utils::async_logger> logger)
+      -> controller_options&
+    {
+      logger_ = std::move(logger);
+      return *this;
+    }
+
+    auto reuse_port() const
+      -> bool
+    {
+      return reuse_port_;
+    }
+
+    // Opens one acceptor per io_service of the pool with SO_REUSEPORT.
+    // Each connection then runs on the io_service which accepted it,
+    // and the placement policy is not used.
+    auto reuse_port(bool const enabled)
+      -> controller_options&
+    {
+      reuse_port_ = enabled;
+      return *this;
+    }
+
   private:
     std::shared_ptr<boost::asio::io_service> io_service_;
     ControllerHandler& handler_;
     std::string address_;
     std::string port_;
     std::shared_ptr<utils::io_service_pool> io_service_pool_;
+    write_coalescing_options write_coalescing_;
+    write_backpressure_options write_backpressure_;
+    bool work_stealing_;
+    utils::placement_policy placement_;
+    std::shared_ptr<utils::async_logger> logger_;
+    bool reuse_port_;
   };
 
 } // namespace controller
@@ -0,0 +1,180 @@
+#ifndef CANARD_NETWORK_OPENFLOW_PROFILING_DECORATOR_HPP
+#define CANARD_NETWORK_OPENFLOW_PROFILING_DECORATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <canard/net/ofp/controller/decorator.hpp>
+#include <canard/net/utils/histogram.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+
+  // Time spent in the downstream handlers, in nanoseconds, per message type.
+  struct handler_profile
+  {
+    // Message types at or above max_message_types and messages without type
+    // (e.g. goodbye) are recorded in the last.
+    static constexpr std::size_t max_message_types = 32;
+
+    void merge(handler_profile const& other) noexcept
+    {
+      for (auto i = std::size_t{0}; i < max_message_types; ++i) {
+        handler_time[i].merge(other.handler_time[i]);
+      }
+    }
+
+    std::array<utils::histogram_snapshot, max_message_types> handler_time;
+  };
+
+  namespace profiling_detail {
+
+    template <class Message>
+    auto message_type_index(Message const& msg, int) noexcept
+      -> decltype(std::size_t(msg.type()))
+    {
+      return std::min<std::size_t>(
+          msg.type(), handler_profile::max_message_types - 1);
+    }
+
+    template <class Message>
+    auto message_type_index(Message const&, long) noexcept
+      -> std::size_t
+    {
+      return handler_profile::max_message_types - 1;
+    }
+
+    struct thread_histograms
+    {
+      std::array<utils::histogram, handler_profile::max_message_types> times;
+    };
+
+    // Histograms recorded by each thread which has called the handler.
+    // A thread finds its own histograms through a thread local cache,
+    // so recording takes no lock once the thread is registered.
+    class profiler
+    {
+      using cache_entry = std::pair<std::uint64_t, thread_histograms*>;
+
+    public:
+      profiler()
+        : id_{next_id()}
+      {
+      }
+
+      profiler(profiler const&) = delete;
+      auto operator=(profiler const&) -> profiler& = delete;
+
+      template <class Rep, class Period>
+      void record(
+            std::size_t const index
+          , std::chrono::duration<Rep, Period> const& time)
+      {
+        local_histograms().times[index].record(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+      }
+
+      auto profile() const
+        -> handler_profile
+      {
+        auto profile = handler_profile{};
+        std::lock_guard<std::mutex> lock{mutex_};
+        for (auto const& histograms : threads_) {
+          for (auto i = std::size_t{0}; i < histograms->times.size(); ++i) {
+            profile.handler_time[i].merge(histograms->times[i].snapshot());
+          }
+        }
+        return profile;
+      }
+
+    private:
+      auto local_histograms()
+        -> thread_histograms&
+      {
+        // ids are never reused, so entries of destroyed profilers never match
+        static thread_local std::vector<cache_entry> cache;
+        for (auto const& entry : cache) {
+          if (entry.first == id_) {
+            return *entry.second;
+          }
+        }
+        auto histograms
+          = std::unique_ptr<thread_histograms>{new thread_histograms{}};
+        auto const result = histograms.get();
+        {
+          std::lock_guard<std::mutex> lock{mutex_};
+          threads_.push_back(std::move(histograms));
+        }
+        cache.emplace_back(id_, result);
+        return *result;
+      }
+
+      static auto next_id() noexcept
+        -> std::uint64_t
+      {
+        static std::atomic<std::uint64_t> id{0};
+        return id.fetch_add(1, std::memory_order_relaxed);
+      }
+
+    private:
+      std::uint64_t id_;
+      mutable std::mutex mutex_;
+      std::vector<std::unique_ptr<thread_histograms>> threads_;
+    };
+
+  } // namespace profiling_detail
+
+  // Decorator which measures the time spent in the downstream handlers.
+  // The messages which the handler ignores by ignored_message are dropped
+  // before reaching the decorator, so they are not measured.
+  // Defining CANARD_NET_OFP_CONTROLLER_DISABLE_PROFILING compiles the
+  // measurement out, and profile() returns an empty profile.
+  template <class Base>
+  class profiling_decorator
+    : public Base
+  {
+  public:
+    template <class Channel, class Message>
+    void handle(Channel const& channel, Message&& msg)
+    {
+#if defined(CANARD_NET_OFP_CONTROLLER_DISABLE_PROFILING)
+      this->forward(channel, std::forward<Message>(msg));
+#else
+      auto const index = profiling_detail::message_type_index(msg, 0);
+      auto const start = std::chrono::steady_clock::now();
+      this->forward(channel, std::forward<Message>(msg));
+      profiler_.record(index, std::chrono::steady_clock::now() - start);
+#endif
+    }
+
+    auto profile() const
+      -> handler_profile
+    {
+#if defined(CANARD_NET_OFP_CONTROLLER_DISABLE_PROFILING)
+      return handler_profile{};
+#else
+      return profiler_.profile();
+#endif
+    }
+
+  private:
+#if !defined(CANARD_NET_OFP_CONTROLLER_DISABLE_PROFILING)
+    profiling_detail::profiler profiler_;
+#endif
+  };
+
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_PROFILING_DECORATOR_HPP
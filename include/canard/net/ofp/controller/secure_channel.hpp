@@ -3,19 +3,31 @@
 
 #include <cstddef>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/error.hpp>
 #include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/system/error_code.hpp>
 #include <canard/asio/asio_handler_hook_propagation.hpp>
 #include <canard/asio/async_result_init.hpp>
+#include <canard/asio/detail/bind_handler.hpp>
+#include <canard/asio/recycling_handler.hpp>
 #include <canard/asio/suppress_asio_async_result_propagation.hpp>
 #include <canard/asio/write_queue_stream.hpp>
+#include <canard/net/ofp/controller/channel_metrics.hpp>
 #include <canard/net/ofp/controller/decorator.hpp>
 #include <canard/net/ofp/controller/detail/null_handler.hpp>
+#include <canard/net/ofp/controller/message_sequence.hpp>
 #include <canard/net/ofp/controller/shared_buffer_generator.hpp>
 #include <canard/net/ofp/controller/with_buffer.hpp>
+#include <canard/net/ofp/controller/write_backpressure.hpp>
+#include <canard/net/ofp/controller/write_coalescing.hpp>
 
 namespace canard {
 namespace net {
@@ -27,6 +39,37 @@ namespace controller {
     template <class ChannelDataMap, class Socket>
     class secure_channel_with_data;
 
+    // Single buffer sequence which owns the bytes it refers to.
+    class shared_bytes
+    {
+    public:
+      using value_type = boost::asio::const_buffer;
+      using const_iterator = boost::asio::const_buffer const*;
+
+      explicit shared_bytes(std::vector<unsigned char>&& bytes)
+        : bytes_{std::make_shared<std::vector<unsigned char>>(
+            std::move(bytes))}
+        , buffer_{boost::asio::buffer(*bytes_)}
+      {
+      }
+
+      auto begin() const noexcept
+        -> const_iterator
+      {
+        return &buffer_;
+      }
+
+      auto end() const noexcept
+        -> const_iterator
+      {
+        return &buffer_ + 1;
+      }
+
+    private:
+      std::shared_ptr<std::vector<unsigned char>> bytes_;
+      boost::asio::const_buffer buffer_;
+    };
+
   } // namespace detail
 
   template <class Socket>
@@ -38,12 +81,39 @@ namespace controller {
         typename std::decay<WriteHandler>::type
       , void(boost::system::error_code, std::size_t)
     >;
+    template <class WaitHandler>
+    using async_wait_result_init = canard::async_result_init<
+        typename std::decay<WaitHandler>::type
+      , void(boost::system::error_code)
+    >;
 
   public:
-    secure_channel(Socket socket, boost::asio::io_service::strand strand)
+    secure_channel(
+          Socket socket, boost::asio::io_service::strand strand
+        , write_coalescing_options const& coalescing_options
+            = write_coalescing_options{}
+        , write_backpressure_options const& backpressure_options
+            = write_backpressure_options{})
       : stream_{std::move(socket), strand}
       , strand_{std::move(strand)}
+      , coalescer_{coalescing_options}
+      , flush_timer_{stream_.get_io_service()}
+      , is_flush_timer_armed_{false}
+      , in_dispatch_{false}
+      , backlog_{std::make_shared<detail::write_backlog>(
+            stream_.get_io_service(), strand_, backpressure_options)}
+      , metrics_{std::make_shared<detail::channel_metrics>(
+            remote_endpoint_of(stream_.lowest_layer()))}
+    {
+      boost::asio::use_service<channel_metrics_registry>(get_io_service())
+        .add(metrics_);
+    }
+
+    ~secure_channel()
     {
+      backlog_->close();
+      boost::asio::use_service<channel_metrics_registry>(get_io_service())
+        .remove(metrics_.get());
     }
 
     auto get_io_service()
@@ -79,12 +149,45 @@ namespace controller {
     void close()
     {
       auto channel = this->shared_from_this();
-      strand_.dispatch([channel]{
+      strand_.dispatch(canard::make_recycling_handler([channel]{
+          auto ignore = boost::system::error_code{};
+          channel->flush_timer_.cancel(ignore);
+          channel->backlog_->close();
           if (channel->stream_.lowest_layer().is_open()) {
-            auto ignore = boost::system::error_code{};
             channel->stream_.lowest_layer().close(ignore);
           }
-      });
+      }));
+    }
+
+    // Bytes queued to the channel and not yet written.
+    auto write_queue_bytes() const noexcept
+      -> std::size_t
+    {
+      return backlog_->bytes();
+    }
+
+    auto is_writable() const noexcept
+      -> bool
+    {
+      return backlog_->is_writable();
+    }
+
+    // Completes when the queued bytes fall to the low water mark,
+    // or immediately if the channel is writable.
+    template <class WaitHandler>
+    auto async_wait_writable(WaitHandler&& handler)
+      -> typename async_wait_result_init<WaitHandler>::result_type
+    {
+      async_wait_result_init<WaitHandler> init{
+        std::forward<WaitHandler>(handler)
+      };
+      auto backlog = backlog_;
+      auto wait_handler = std::move(init.handler());
+      strand_.dispatch(canard::make_recycling_handler(
+            [backlog, wait_handler]() mutable {
+              backlog->async_wait_writable(std::move(wait_handler));
+      }));
+      return init.get();
     }
 
     template <class Message, class Buffer, class WriteHandler>
@@ -93,19 +196,13 @@ namespace controller {
         , WriteHandler&& handler)
       -> typename async_write_result_init<WriteHandler>::result_type
     {
-      if (strand_.running_in_this_thread()) {
-        return async_write_some(
-            msg.encode(), std::forward<WriteHandler>(handler));
-      }
-      else {
-        async_write_result_init<WriteHandler> init{
-          std::forward<WriteHandler>(handler)
-        };
-        strand_.post(make_async_write_functor(
-                this->shared_from_this()
-              , std::move(init.handler()), msg.encode()));
-        return init.get();
+      if (backlog_->should_drop(msg.type())) {
+        metrics_->count_dropped();
+        return async_drop(std::forward<WriteHandler>(handler));
       }
+      metrics_->count_sent(msg.type(), msg.length());
+      return async_send_buffers(
+          msg.encode(), std::forward<WriteHandler>(handler));
     }
 
     template <class Message, class WriteHandler>
@@ -124,17 +221,230 @@ namespace controller {
       return async_send(msg, detail::null_handler{});
     }
 
+    template <class MessageSequence, class WriteHandler>
+    auto async_send_all(MessageSequence const& msgs, WriteHandler&& handler)
+      -> typename async_write_result_init<WriteHandler>::result_type
+    {
+      if (backlog_->is_dropping()) {
+        // encodes into a vector to remove the dropped packet_outs
+        auto bytes = std::vector<unsigned char>{};
+        message_sequence_detail::for_each(
+              msgs
+            , message_sequence_detail::encoder<std::vector<unsigned char>>{
+                bytes
+              });
+        return async_send_encoded(
+            std::move(bytes), std::forward<WriteHandler>(handler));
+      }
+      message_sequence_detail::for_each(
+          msgs, detail::sent_message_counter{*metrics_});
+      return async_send_buffers(
+          encode_all(msgs), std::forward<WriteHandler>(handler));
+    }
+
+    template <class MessageSequence>
+    auto async_send_all(MessageSequence const& msgs)
+      -> typename async_write_result_init<detail::null_handler>::result_type
+    {
+      return async_send_all(msgs, detail::null_handler{});
+    }
+
+    // Sends messages already encoded back to back in bytes as one buffer.
+    template <class WriteHandler>
+    auto async_send_encoded(
+        std::vector<unsigned char>&& bytes, WriteHandler&& handler)
+      -> typename async_write_result_init<WriteHandler>::result_type
+    {
+      if (auto const num_dropped = backlog_->remove_dropped(bytes)) {
+        metrics_->count_dropped(num_dropped);
+        if (bytes.empty()) {
+          return async_drop(std::forward<WriteHandler>(handler));
+        }
+      }
+      detail::count_sent_encoded(
+          *metrics_, bytes.data(), bytes.data() + bytes.size());
+      return async_send_buffers(
+            detail::shared_bytes{std::move(bytes)}
+          , std::forward<WriteHandler>(handler));
+    }
+
+    auto async_send_encoded(std::vector<unsigned char>&& bytes)
+      -> typename async_write_result_init<detail::null_handler>::result_type
+    {
+      return async_send_encoded(std::move(bytes), detail::null_handler{});
+    }
+
   protected:
     template <class ConstBufferSequence, class WriteHandler>
     auto async_write_some(ConstBufferSequence&& buffers, WriteHandler&& handler)
       -> typename async_write_result_init<WriteHandler>::result_type
     {
+      flush_pending_writes();
       return stream_.async_write_some(
             std::forward<ConstBufferSequence>(buffers)
           , std::forward<WriteHandler>(handler));
     }
 
+    void flush_pending_writes()
+    {
+      if (!coalescer_.empty()) {
+        async_write_tracked(coalescer_.take(), detail::null_handler{});
+      }
+    }
+
+    auto metrics() noexcept
+      -> detail::channel_metrics&
+    {
+      return *metrics_;
+    }
+
+    // The reader dispatches the received messages between these calls.
+    // Only the messages sent during the dispatch wait for its end.
+    void begin_dispatch() noexcept
+    {
+      in_dispatch_ = true;
+    }
+
+    void end_dispatch()
+    {
+      in_dispatch_ = false;
+      if (coalescer_.options().flush_at_handler_exit()) {
+        flush_pending_writes();
+      }
+    }
+
   private:
+    template <class ConstBufferSequence, class WriteHandler>
+    auto async_send_buffers(
+        ConstBufferSequence&& buffers, WriteHandler&& handler)
+      -> typename async_write_result_init<WriteHandler>::result_type
+    {
+      using is_null_handler = std::is_same<
+        typename std::decay<WriteHandler>::type, detail::null_handler
+      >;
+      backlog_->add(boost::asio::buffer_size(buffers));
+      if (is_null_handler::value && coalescer_.options().is_enabled()) {
+        return async_coalesce(
+              std::forward<ConstBufferSequence>(buffers)
+            , std::forward<WriteHandler>(handler));
+      }
+      async_write_result_init<WriteHandler> init{
+        std::forward<WriteHandler>(handler)
+      };
+      if (strand_.running_in_this_thread()) {
+        flush_pending_writes();
+        async_write_tracked(
+              std::forward<ConstBufferSequence>(buffers)
+            , std::move(init.handler()));
+      }
+      else {
+        strand_.post(make_async_write_functor(
+                this->shared_from_this()
+              , std::move(init.handler())
+              , std::forward<ConstBufferSequence>(buffers)));
+      }
+      return init.get();
+    }
+
+    template <class ConstBufferSequence, class WriteHandler>
+    void async_write_tracked(
+        ConstBufferSequence&& buffers, WriteHandler&& handler)
+    {
+      auto const bytes = boost::asio::buffer_size(buffers);
+      stream_.async_write_some(
+            std::forward<ConstBufferSequence>(buffers)
+          , canard::suppress_asio_async_result_propagation(
+              detail::make_write_tracking_handler(
+                  metrics_
+                , detail::make_backlog_release_handler(
+                    backlog_, bytes, std::forward<WriteHandler>(handler)))));
+    }
+
+    template <class WriteHandler>
+    auto async_drop(WriteHandler&& handler)
+      -> typename async_write_result_init<WriteHandler>::result_type
+    {
+      async_write_result_init<WriteHandler> init{
+        std::forward<WriteHandler>(handler)
+      };
+      strand_.post(canard::detail::bind(
+            std::move(init.handler())
+          , boost::system::error_code{boost::asio::error::no_buffer_space}
+          , std::size_t{0}));
+      return init.get();
+    }
+
+    template <class Stream>
+    static auto remote_endpoint_of(Stream& stream)
+      -> std::string
+    {
+      auto ec = boost::system::error_code{};
+      auto const endpoint = stream.remote_endpoint(ec);
+      if (ec) {
+        return std::string{};
+      }
+      std::ostringstream oss;
+      oss << endpoint;
+      return oss.str();
+    }
+
+    template <class ConstBufferSequence, class WriteHandler>
+    auto async_coalesce(ConstBufferSequence&& buffers, WriteHandler&& handler)
+      -> typename async_write_result_init<WriteHandler>::result_type
+    {
+      async_write_result_init<WriteHandler> init{
+        std::forward<WriteHandler>(handler)
+      };
+      if (strand_.running_in_this_thread()) {
+        coalesce(buffers);
+      }
+      else {
+        auto channel = this->shared_from_this();
+        auto const pending = typename std::decay<ConstBufferSequence>::type(
+            std::forward<ConstBufferSequence>(buffers));
+        strand_.post(canard::make_recycling_handler([channel, pending]{
+            channel->coalesce(pending);
+        }));
+      }
+      return init.get();
+    }
+
+    template <class ConstBufferSequence>
+    void coalesce(ConstBufferSequence const& buffers)
+    {
+      if (!coalescer_.fits(boost::asio::buffer_size(buffers))) {
+        flush_pending_writes();
+      }
+      coalescer_.append(buffers);
+      if (coalescer_.is_full()) {
+        flush_pending_writes();
+        return;
+      }
+      if (coalescer_.options().max_delay().count() != 0) {
+        arm_flush_timer();
+      }
+      else if (!in_dispatch_) {
+        flush_pending_writes();
+      }
+    }
+
+    void arm_flush_timer()
+    {
+      if (is_flush_timer_armed_) {
+        return;
+      }
+      is_flush_timer_armed_ = true;
+      flush_timer_.expires_from_now(coalescer_.options().max_delay());
+      auto channel = this->shared_from_this();
+      flush_timer_.async_wait(strand_.wrap(canard::make_recycling_handler(
+            [channel](boost::system::error_code const& ec) {
+              channel->is_flush_timer_armed_ = false;
+              if (!ec) {
+                channel->flush_pending_writes();
+              }
+      })));
+    }
+
     template <class WriteHandler, class ConstBufferSequence>
     struct async_write_functor
       : canard::asio_handler_hook_propagation<
@@ -152,10 +462,9 @@ namespace controller {
 
       void operator()()
       {
-        channel_->async_write_some(
-              std::move(buffers_)
-            , canard::suppress_asio_async_result_propagation(
-                std::move(handler_)));
+        channel_->flush_pending_writes();
+        channel_->async_write_tracked(
+            std::move(buffers_), std::move(handler_));
       }
 
       auto handler() noexcept
@@ -191,6 +500,14 @@ namespace controller {
   protected:
     canard::write_queue_stream<Socket, boost::asio::io_service::strand> stream_;
     boost::asio::io_service::strand strand_;
+
+  private:
+    detail::write_coalescer coalescer_;
+    boost::asio::steady_timer flush_timer_;
+    bool is_flush_timer_armed_;
+    bool in_dispatch_;
+    std::shared_ptr<detail::write_backlog> backlog_;
+    std::shared_ptr<detail::channel_metrics> metrics_;
   };
 
 } // namespace controller
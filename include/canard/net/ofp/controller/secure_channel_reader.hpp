@@ -2,45 +2,36 @@
 #define CANARD_NETWORK_OPENFLOW_SECURE_CHANNEL_READER_HPP
 
 #include <cstddef>
-#include <cstring>
+#include <chrono>
 #include <iterator>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/completion_condition.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/read.hpp>
 #include <boost/asio/strand.hpp>
-#include <boost/asio/streambuf.hpp>
-#include <boost/endian/conversion.hpp>
 #include <boost/system/error_code.hpp>
+#include <canard/asio/buffer_pool.hpp>
 #include <canard/asio/detail/bind_handler.hpp>
+#include <canard/asio/receive_buffer.hpp>
 #include <canard/net/ofp/hello.hpp>
 #include <canard/net/ofp/controller/decorator.hpp>
+#include <canard/net/ofp/controller/detail/reader_access.hpp>
 #include <canard/net/ofp/controller/goodbye.hpp>
+#include <canard/net/ofp/controller/ignored_message.hpp>
+#include <canard/net/ofp/controller/message_batch.hpp>
+#include <canard/net/ofp/controller/message_view.hpp>
 #include <canard/net/ofp/controller/secure_channel.hpp>
-
-#include <iostream>
+#include <canard/net/utils/async_logger.hpp>
+#include <canard/net/utils/io_service_load.hpp>
 
 namespace canard {
 namespace net {
 namespace ofp {
 namespace controller {
 
-  namespace secure_channel_detail {
-
-    template <class Data>
-    auto read(unsigned char const* const src)
-      -> Data
-    {
-      auto data = Data{};
-      std::memcpy(&data, src, sizeof(data));
-      boost::endian::big_to_native_inplace(data);
-      return data;
-    }
-
-  } // namespace secure_channel_detail
-
   namespace detail {
 
     template <class ChannelDataMap, class Socket>
@@ -82,123 +73,196 @@ namespace controller {
     >;
     using channel_ptr = std::shared_ptr<secure_channel<Socket>>;
     using header_type = typename MessageHandler::header_type;
+    using decode_policy = detail::decode_policy_t<ControllerHandler>;
 
   public:
     secure_channel_reader(
           Socket socket
         , boost::asio::io_service::strand strand
-        , ControllerHandler& controller_handler)
-      : base_type{std::move(socket), std::move(strand)}
+        , ControllerHandler& controller_handler
+        , std::shared_ptr<utils::async_logger> logger
+        , utils::connection_count connection
+        , write_coalescing_options const& coalescing_options
+            = write_coalescing_options{}
+        , write_backpressure_options const& backpressure_options
+            = write_backpressure_options{})
+      : base_type{
+            std::move(socket), std::move(strand)
+          , coalescing_options, backpressure_options
+        }
       , controller_handler_(controller_handler)
+      , logger_(std::move(logger))
+      , buffer_{0}
+      , connection_(std::move(connection))
     {
     }
 
     ~secure_channel_reader()
     {
-      std::cout << __func__ << std::endl;
+      logger_->debug(__func__);
     }
 
     void run(net::ofp::hello&& hello)
     {
+      run(std::move(hello), canard::receive_buffer{});
+    }
+
+    // Starts the message loop with the bytes already received after hello.
+    void run(net::ofp::hello&& hello, canard::receive_buffer&& buffer)
+    {
+      buffer_ = std::move(buffer);
       auto base_channel = this->shared_from_this();
+      this->begin_dispatch();
       handle(base_channel, std::move(hello));
+      this->end_dispatch();
       auto loop = message_loop{this, std::move(base_channel)};
       loop.run();
     }
 
   private:
     friend MessageHandler;
+    friend detail::reader_access;
 
+    // Defining CANARD_NET_OFP_CONTROLLER_DISABLE_PROFILING also compiles
+    // out the handler time of the channel metrics.
     template <class Message>
     void handle(channel_ptr const& channel, Message&& msg)
     {
-      detail::handle(controller_handler_, channel, std::forward<Message>(msg));
+#if defined(CANARD_NET_OFP_CONTROLLER_DISABLE_PROFILING)
+      detail::handle(
+            controller_handler_, channel
+          , detail::apply_decode_policy(
+              decode_policy{}, std::forward<Message>(msg)));
+#else
+      auto const start = std::chrono::steady_clock::now();
+      detail::handle(
+            controller_handler_, channel
+          , detail::apply_decode_policy(
+              decode_policy{}, std::forward<Message>(msg)));
+      this->metrics().record_handler_time(
+          std::chrono::steady_clock::now() - start);
+#endif
     }
 
-  private:
-    struct read_handler_storage
+    void handle_decode_error()
     {
-      typename std::aligned_storage<256>::type memory;
-      bool used = false;
-    };
+      this->metrics().count_decode_error();
+    }
 
+  private:
     struct message_loop
     {
       void run()
       {
-        auto const least_size = sizeof(header_type);
-        reader_->strand_.dispatch(canard::detail::bind(*this, least_size));
+        // handles the bytes already in the buffer before the first read
+        reader_->strand_.dispatch(canard::detail::bind(
+              *this, boost::system::error_code{}, std::size_t{0}));
       }
 
       void operator()(std::size_t const least_size)
       {
         boost::asio::async_read(
-              reader_->stream_, reader_->streambuf_
+              reader_->stream_, reader_->buffer_.prepare(least_size)
             , boost::asio::transfer_at_least(least_size)
             , reader_->strand_.wrap(*this));
       }
 
-      void operator()(boost::system::error_code const& ec, std::size_t)
+      void operator()(
+          boost::system::error_code const& ec, std::size_t const bytes)
       {
+        reader_->buffer_.commit(bytes);
+        reader_->begin_dispatch();
         if (ec) {
-          handle_read(reader_->streambuf_);
+          handle_read(reader_->buffer_);
           reader_->handle(base_channel_, goodbye{ec});
-          std::cout
-            << "connection closed: " << ec.message()
-            << " " << base_channel_.use_count() << std::endl;
+          reader_->end_dispatch();
+          reader_->logger_->info(
+                "connection closed: ", ec.message()
+              , " ", base_channel_.use_count());
           return;
         }
-        auto const least_size = handle_read(reader_->streambuf_);
+        auto const least_size = handle_read(reader_->buffer_);
+        reader_->end_dispatch();
         (*this)(least_size);
       }
 
-      auto handle_read(boost::asio::streambuf& streambuf)
+      auto handle_read(canard::receive_buffer& buffer)
         -> std::size_t
       {
-        while (streambuf.size() >= sizeof(header_type)) {
-          auto first
-            = boost::asio::buffer_cast<unsigned char const*>(streambuf.data());
+        return handle_read(
+            buffer, detail::is_batch_dispatch_handler<ControllerHandler>{});
+      }
+
+      auto handle_read(canard::receive_buffer& buffer, std::false_type)
+        -> std::size_t
+      {
+        while (buffer.size() >= sizeof(header_type)) {
+          auto const first = buffer.data();
 
           auto const header = secure_channel_detail::read<header_type>(first);
-          if (streambuf.size() < header.length) {
-            return header.length - streambuf.size();
+          if (buffer.size() < header.length) {
+            return header.length - buffer.size();
           }
 
           auto const last = std::next(first, header.length);
+          reader_->connection_.load().add_messages(1);
+          reader_->metrics().count_received(header.type, header.length);
           MessageHandler{}(reader_, base_channel_, header, first, last);
 
-          streambuf.consume(header.length);
+          buffer.consume(header.length);
         }
-        return sizeof(header_type) - streambuf.size();
+        return sizeof(header_type) - buffer.size();
       }
 
-      auto storage() const noexcept
-        -> read_handler_storage&
+      auto handle_read(canard::receive_buffer& buffer, std::true_type)
+        -> std::size_t
       {
-        return reader_->storage_;
+        auto const first = buffer.data();
+        auto const end = std::next(first, buffer.size());
+        auto last = first;
+        auto num_messages = std::size_t{0};
+        auto least_size = std::size_t{0};
+        while (true) {
+          auto const rest_size = std::size_t(std::distance(last, end));
+          if (rest_size < sizeof(header_type)) {
+            least_size = sizeof(header_type) - rest_size;
+            break;
+          }
+          auto const header = secure_channel_detail::read<header_type>(last);
+          if (rest_size < header.length) {
+            least_size = header.length - rest_size;
+            break;
+          }
+          std::advance(last, header.length);
+          ++num_messages;
+          reader_->metrics().count_received(header.type, header.length);
+        }
+
+        if (num_messages != 0) {
+          reader_->connection_.load().add_messages(num_messages);
+          reader_->handle(
+                base_channel_
+              , message_batch<
+                    MessageHandler, secure_channel_reader, channel_ptr
+                  , decode_policy
+                  , detail::intercepted_message_list_t<ControllerHandler>
+                >{first, last, num_messages, reader_, base_channel_});
+          buffer.consume(std::distance(first, last));
+        }
+        return least_size;
       }
 
-      friend auto asio_handler_allocate(
-          std::size_t const size, message_loop* const loop)
+      // Same storage as canard::recycling_handler used by the write path.
+      friend auto asio_handler_allocate(std::size_t const size, message_loop*)
         -> void*
       {
-        auto& storage = loop->storage();
-        if (!storage.used && size <= sizeof(storage.memory)) {
-          storage.used = true;
-          return std::addressof(storage.memory);
-        }
-        return operator new(size);
+        return canard::buffer_pool::allocate(size);
       }
 
       friend void asio_handler_deallocate(
-          void* const pointer, std::size_t, message_loop* const loop)
+          void* const pointer, std::size_t const size, message_loop*)
       {
-        auto& storage = loop->storage();
-        if (pointer == std::addressof(storage.memory)) {
-          storage.used = false;
-          return;
-        }
-        operator delete(pointer);
+        canard::buffer_pool::deallocate(pointer, size);
       }
 
       secure_channel_reader* reader_;
@@ -207,8 +271,10 @@ namespace controller {
 
   private:
     ControllerHandler& controller_handler_;
-    boost::asio::streambuf streambuf_;
-    read_handler_storage storage_;
+    std::shared_ptr<utils::async_logger> logger_;
+    // empty until run hands over the buffer used for the handshake
+    canard::receive_buffer buffer_;
+    utils::connection_count connection_;
   };
 
 } // namespace controller
@@ -3,10 +3,8 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <cstring>
 #include <chrono>
 #include <functional>
-#include <iostream>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -16,11 +14,9 @@
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/read.hpp>
-#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/dynamic_bitset/dynamic_bitset.hpp>
-#include <boost/endian/conversion.hpp>
 #include <boost/fusion/adapted/std_tuple.hpp>
 #include <boost/fusion/algorithm/iteration/for_each.hpp>
 #include <boost/mpl/bool.hpp>
@@ -28,10 +24,17 @@
 #include <boost/system/error_code.hpp>
 #include <boost/utility/string_ref.hpp>
 #include <canard/asio/asio_handler_hook_propagation.hpp>
+#include <canard/asio/receive_buffer.hpp>
 #include <canard/net/ofp/error.hpp>
 #include <canard/net/ofp/hello.hpp>
 #include <canard/net/ofp/type_traits/type_list.hpp>
+#include <canard/net/ofp/controller/detail/read.hpp>
 #include <canard/net/ofp/controller/with_buffer.hpp>
+#include <canard/net/ofp/controller/write_backpressure.hpp>
+#include <canard/net/ofp/controller/write_coalescing.hpp>
+#include <canard/net/utils/async_logger.hpp>
+#include <canard/net/utils/io_service_load.hpp>
+#include <canard/net/utils/timer_wheel.hpp>
 
 namespace canard {
 namespace net {
@@ -56,17 +59,17 @@ namespace detail {
       , greater_version
     >::type::tuple;
 
-    auto is_valid_hello(net::ofp::ofp_header const header)
+    inline auto is_valid_hello(
+        net::ofp::ofp_header const header, utils::async_logger& logger)
       -> bool
     {
       if (header.type != net::ofp::hello::message_type) {
-        std::cout
-          << "not hello message: " << std::uint32_t{header.type} << std::endl;
+        logger.warning("not hello message: ", std::uint32_t{header.type});
         return false;
       }
 
       if (header.length < sizeof(net::ofp::ofp_header)) {
-        std::cout << "invalid message length: " << header.length << std::endl;
+        logger.warning("invalid message length: ", header.length);
         return false;
       }
 
@@ -75,7 +78,7 @@ namespace detail {
 
     class timer
     {
-      using timer_type = boost::asio::steady_timer;
+      using timer_type = utils::wheel_timer;
 
     public:
       using duration = timer_type::duration;
@@ -178,15 +181,6 @@ namespace detail {
       return net::ofp::hello_elements::versionbitmap{creator.bitmaps()};
     }
 
-    inline auto read_ofp_header(std::vector<unsigned char> const& buffer)
-      -> net::ofp::ofp_header
-    {
-      auto header = net::ofp::ofp_header{};
-      std::memcpy(&header, buffer.data(), sizeof(header));
-      boost::endian::big_to_native_inplace(header);
-      return header;
-    }
-
   } // namespace setup_connection_detail
 
   template <class ControllerHandler>
@@ -201,13 +195,25 @@ namespace detail {
 
   public:
     setup_connection(
-        ControllerHandler& handler, boost::asio::io_service& io_service)
+          ControllerHandler& handler, boost::asio::io_service& io_service
+        , std::shared_ptr<utils::async_logger> logger
+        , write_coalescing_options const& coalescing_options
+            = write_coalescing_options{}
+        , write_backpressure_options const& backpressure_options
+            = write_backpressure_options{})
       : handler_(handler)
       , socket_{io_service}
       , timer_{io_service}
       , strand_{io_service}
       , buffer_{}
+      , receive_buffer_{}
       , endpoint_{}
+      , logger_(std::move(logger))
+      , connection_{io_service}
+      , coalescing_options_(coalescing_options)
+      , backpressure_options_(backpressure_options)
+      , is_hello_sent_{false}
+      , is_hello_received_{false}
     {
     }
 
@@ -228,6 +234,7 @@ namespace detail {
       auto self = this->shared_from_this();
       strand_.post([this, self]{
           async_send_hello(self);
+          async_receive_hello(self, sizeof(net::ofp::ofp_header));
           set_connection_timeout(self);
       });
     }
@@ -235,9 +242,12 @@ namespace detail {
   private:
     void close(boost::string_ref const& reason)
     {
+      if (!socket_.is_open()) {
+        return;
+      }
       auto ignore = boost::system::error_code{};
       socket_.close(ignore);
-      std::cout << reason << std::endl;
+      logger_->warning(reason);
     }
 
     void async_send_hello(std::shared_ptr<setup_connection> const& self)
@@ -250,67 +260,52 @@ namespace detail {
           , ofp::controller::with_buffer(std::move(hello), buffer_).encode()
           , strand_.wrap([this, self](
               boost::system::error_code const& ec, std::size_t) {
-            cancel_connection_timeout();
             if (ec) {
               close("failed to send hello: " + ec.message());
               return;
             }
-            async_receive_hello(self);
-            set_connection_timeout(self);
+            is_hello_sent_ = true;
+            if (is_hello_received_) {
+              handle_hello(self);
+            }
       }));
     }
 
-    void async_receive_hello(std::shared_ptr<setup_connection> const& self)
+    // The hello is read into the receive buffer which is handed over to
+    // the channel, so that messages following it in the same read are
+    // handled by the channel without being read again.
+    void async_receive_hello(
+          std::shared_ptr<setup_connection> const& self
+        , std::size_t const least_size)
     {
       boost::asio::async_read(
-            socket_, boost::asio::buffer(buffer_)
-          , boost::asio::transfer_exactly(sizeof(net::ofp::ofp_header))
+            socket_, receive_buffer_.prepare(least_size)
+          , boost::asio::transfer_at_least(least_size)
           , strand_.wrap([this, self](
-              boost::system::error_code const& ec, std::size_t) {
-            cancel_connection_timeout();
+              boost::system::error_code const& ec, std::size_t const bytes) {
+            receive_buffer_.commit(bytes);
             if (ec) {
               close("failed to receive hello: " + ec.message());
               return;
             }
 
-            auto const header
-              = setup_connection_detail::read_ofp_header(buffer_);
-            if (!setup_connection_detail::is_valid_hello(header)) {
+            auto const header = secure_channel_detail::read<
+              net::ofp::ofp_header
+            >(receive_buffer_.data());
+            if (!setup_connection_detail::is_valid_hello(header, *logger_)) {
               close("received invalid hello message");
               return;
             }
 
-            auto const header_length = sizeof(net::ofp::ofp_header);
-            if (header.length == header_length) {
-              buffer_.resize(header_length);
-              handle_hello(self);
-            }
-            else {
-              async_receive_hello_elements(self, header.length - header_length);
-              set_connection_timeout(self);
-            }
-      }));
-    }
-
-    void async_receive_hello_elements(
-          std::shared_ptr<setup_connection> const& self
-        , std::size_t const elements_length)
-    {
-      auto const header_length = sizeof(net::ofp::ofp_header);
-
-      buffer_.resize(header_length + elements_length);
-      boost::asio::async_read(
-            socket_
-          , boost::asio::buffer(buffer_.data() + header_length, elements_length)
-          , boost::asio::transfer_exactly(elements_length)
-          , strand_.wrap([this, self](
-              boost::system::error_code const& ec, std::size_t) {
-            cancel_connection_timeout();
-            if (ec) {
-              close("failed to receive hello elements: " + ec.message());
+            if (receive_buffer_.size() < header.length) {
+              async_receive_hello(
+                  self, header.length - receive_buffer_.size());
               return;
             }
-            handle_hello(self);
+            is_hello_received_ = true;
+            if (is_hello_sent_) {
+              handle_hello(self);
+            }
       }));
     }
 
@@ -326,8 +321,12 @@ namespace detail {
           >;
           auto const channel = std::make_shared<channel_type>(
                 std::move(connection.socket_)
-              , connection.strand_, connection.handler_);
-          channel->run(std::move(hello));
+              , connection.strand_, connection.handler_
+              , connection.logger_, std::move(connection.connection_)
+              , connection.coalescing_options_
+              , connection.backpressure_options_);
+          channel->run(
+              std::move(hello), std::move(connection.receive_buffer_));
         }
       }
 
@@ -338,8 +337,14 @@ namespace detail {
 
     void handle_hello(std::shared_ptr<setup_connection> const& self)
     {
-      auto it = buffer_.begin();
-      auto hello = net::ofp::hello::decode(it, buffer_.end());
+      cancel_connection_timeout();
+
+      auto const header = secure_channel_detail::read<
+        net::ofp::ofp_header
+      >(receive_buffer_.data());
+      auto it = receive_buffer_.data();
+      auto hello = net::ofp::hello::decode(it, it + header.length);
+      receive_buffer_.consume(header.length);
 
       auto starter = channel_starter{*this, hello, false};
       boost::fusion::for_each(supported_versions{}, std::ref(starter));
@@ -385,7 +390,15 @@ namespace detail {
     setup_connection_detail::timer timer_;
     boost::asio::io_service::strand strand_;
     std::vector<unsigned char> buffer_;
+    canard::receive_buffer receive_buffer_;
     tcp::endpoint endpoint_;
+    std::shared_ptr<utils::async_logger> logger_;
+    // counted from the placement, including the pending accept
+    utils::connection_count connection_;
+    write_coalescing_options coalescing_options_;
+    write_backpressure_options backpressure_options_;
+    bool is_hello_sent_;
+    bool is_hello_received_;
   };
 
 } // namespace detail
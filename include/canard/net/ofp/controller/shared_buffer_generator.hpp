@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <algorithm>
 #include <utility>
+#include <canard/asio/buffer_pool.hpp>
 #include <canard/asio/shared_buffer.hpp>
 
 namespace canard {
@@ -13,23 +14,24 @@ namespace controller {
 
   namespace shared_buffer_generator_detail {
 
-    struct shared_buffer_generator
+    template <class SharedBuffer>
+    struct basic_shared_buffer_generator
     {
       using iterator = unsigned char*;
       using const_iterator = unsigned char const*;
 
-      shared_buffer_generator() noexcept
+      basic_shared_buffer_generator() noexcept
         : buffer{}, it{nullptr}
       {
       }
 
-      explicit shared_buffer_generator(canard::shared_buffer& buffer)
+      explicit basic_shared_buffer_generator(SharedBuffer& buffer)
         : buffer(buffer), it{buffer.data()}
       {
       }
 
-      explicit shared_buffer_generator(canard::shared_buffer&& buffer)
-        : buffer(std::move(buffer)), it{buffer.data()}
+      explicit basic_shared_buffer_generator(SharedBuffer&& buffer)
+        : buffer(std::move(buffer)), it{this->buffer.data()}
       {
       }
 
@@ -73,25 +75,33 @@ namespace controller {
         it = buffer.data();
       }
 
-      canard::shared_buffer buffer;
+      SharedBuffer buffer;
       unsigned char* it;
     };
 
-    auto to_const_buffers(shared_buffer_generator const& buffer)
-      -> canard::shared_buffer const&
+    template <class SharedBuffer>
+    auto to_const_buffers(
+        basic_shared_buffer_generator<SharedBuffer> const& buffer)
+      -> SharedBuffer const&
     {
       return buffer.buffer;
     }
 
-    auto to_const_buffers(shared_buffer_generator&& buffer)
-      -> canard::shared_buffer&&
+    template <class SharedBuffer>
+    auto to_const_buffers(basic_shared_buffer_generator<SharedBuffer>&& buffer)
+      -> SharedBuffer&&
     {
       return std::move(buffer).buffer;
     }
 
   } // namespace shared_buffer_generator_detail
 
-  using shared_buffer_generator_detail::shared_buffer_generator;
+  using shared_buffer_generator_detail::basic_shared_buffer_generator;
+
+  using shared_buffer_generator
+    = basic_shared_buffer_generator<canard::shared_buffer>;
+  using pooled_shared_buffer_generator
+    = basic_shared_buffer_generator<canard::pooled_shared_buffer>;
 
 } // namespace controller
 } // namespace ofp
@@ -1,13 +1,18 @@
 #ifndef CANARD_NETWORK_OPENFLOW_V10_SECURE_CHANNEL_HPP
 #define CANARD_NETWORK_OPENFLOW_V10_SECURE_CHANNEL_HPP
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <stdexcept>
 #include <tuple>
-#include <boost/preprocessor/repeat.hpp>
+#include <utility>
 #include <canard/net/ofp/v10/detail/byteorder.hpp>
 #include <canard/net/ofp/v10/messages.hpp>
 #include <canard/net/ofp/v10/openflow.hpp>
+#include <canard/net/ofp/controller/detail/read.hpp>
+#include <canard/net/ofp/controller/dispatch_table.hpp>
+#include <canard/net/ofp/controller/ignored_message.hpp>
 #include <canard/net/ofp/controller/secure_channel_reader.hpp>
 
 namespace canard {
@@ -16,9 +21,112 @@ namespace ofp {
 namespace controller {
 namespace v10 {
 
-  struct handle_message
+  namespace handle_message_detail {
+
+    using switch_message_list = net::ofp::v10::default_switch_message_list;
+    static_assert(
+          std::tuple_size<switch_message_list>::value == 10
+        , "not match to the number of message types");
+
+    using stats_reply_list = net::ofp::v10::default_stats_reply_list;
+    static_assert(
+          std::tuple_size<stats_reply_list>::value == 6
+        , "not match to the number of stats reply types");
+
+    using all_message_list = decltype(std::tuple_cat(
+          std::declval<switch_message_list>()
+        , std::declval<stats_reply_list>()));
+
+    template <class Message>
+    using decoded_message_t = Message;
+
+    struct message_traits
+    {
+      using header_type = net::ofp::v10::protocol::ofp_header;
+
+      template <class Message>
+      static constexpr auto key() noexcept
+        -> std::size_t
+      {
+        return Message::type();
+      }
+
+      template <class Message, class Reader, class BaseChannel>
+      static void handle(
+            Reader* const reader, BaseChannel const& base_channel
+          , header_type const& header
+          , unsigned char const* first
+          , unsigned char const* const last)
+      {
+        if (!Message::is_valid_message_length(header)) {
+          detail::reader_access::handle_decode_error(reader);
+          throw std::runtime_error{"invalid message length"};
+        }
+        detail::reader_access::handle(
+            reader, base_channel, Message::decode(first, last));
+      }
+
+      template <class Reader, class BaseChannel>
+      static void handle_unknown(
+            Reader* const reader, BaseChannel const&
+          , header_type const&
+          , unsigned char const*, unsigned char const*)
+      {
+        detail::reader_access::handle_decode_error(reader);
+      }
+    };
+
+    struct stats_reply_traits
+    {
+      using header_type = net::ofp::v10::protocol::ofp_stats_reply;
+
+      template <class Message>
+      static constexpr auto key() noexcept
+        -> std::size_t
+      {
+        return Message::stats_type();
+      }
+
+      template <class Message, class Reader, class BaseChannel>
+      static void handle(
+            Reader* const reader, BaseChannel const& base_channel
+          , header_type const& stats_reply
+          , unsigned char const* first
+          , unsigned char const* const last)
+      {
+        if (!Message::is_valid_stats_length(stats_reply)) {
+          detail::reader_access::handle_decode_error(reader);
+          throw std::runtime_error{"invalid stats length"};
+        }
+        detail::reader_access::handle(
+            reader, base_channel, Message::decode(first, last));
+      }
+
+      template <class Reader, class BaseChannel>
+      static void handle_unknown(
+            Reader* const reader, BaseChannel const&
+          , header_type const&
+          , unsigned char const*, unsigned char const*)
+      {
+        detail::reader_access::handle_decode_error(reader);
+      }
+    };
+
+  } // namespace handle_message_detail
+
+  // Dispatches the messages in MessageList, and drops the other messages
+  // without decoding them.
+  template <class MessageList = handle_message_detail::all_message_list>
+  struct basic_handle_message
   {
     using header_type = net::ofp::v10::protocol::ofp_header;
+    using message_list = MessageList;
+
+    static_assert(
+          detail::is_known_message_list<
+            MessageList, handle_message_detail::all_message_list
+          >::value
+        , "message_list contains messages which are not dispatched");
 
     template <class Reader, class BaseChannel>
     void operator()(
@@ -28,34 +136,21 @@ namespace v10 {
         , unsigned char const* const last) const
     {
       if (header.version != net::ofp::v10::protocol::OFP_VERSION) {
+        reader->handle_decode_error();
         throw std::runtime_error{"invalid version"};
       }
-      using message_list = net::ofp::v10::default_switch_message_list;
-      switch (header.type) {
-
-#     define CANARD_NETWORK_OPENFLOW_V10_MESSAGES_CASE(z, N, _) \
-      using msg ## N = std::tuple_element<N, message_list>::type; \
-      case msg ## N::type(): \
-        if (!msg ## N::is_valid_message_length(header)) { \
-          throw std::runtime_error{"invalid message length"}; \
-        } \
-        reader->handle(base_channel, msg ## N::decode(first, last)); \
-        break;
-      static_assert(
-            std::tuple_size<message_list>::value == 10
-          , "not match to the number of message types");
-      BOOST_PP_REPEAT(10, CANARD_NETWORK_OPENFLOW_V10_MESSAGES_CASE, _)
-#     undef  CANARD_NETWORK_OPENFLOW_V10_MESSAGES_CASE
-
-      case net::ofp::v10::protocol::OFPT_STATS_REPLY:
+      if (header.type == net::ofp::v10::protocol::OFPT_STATS_REPLY) {
         if (header.length < sizeof(net::ofp::v10::protocol::ofp_stats_reply)) {
+          reader->handle_decode_error();
           throw std::runtime_error{"invalid message length"};
         }
         handle_stats_reply(reader, base_channel, first, last);
-        break;
-      default:
-        break;
+        return;
       }
+      dispatch_table<
+          handle_message_detail::message_traits
+        , handle_message_detail::switch_message_list, MessageList
+      >::dispatch(header.type, reader, base_channel, header, first, last);
     }
 
     template <class Reader, class BaseChannel>
@@ -67,32 +162,31 @@ namespace v10 {
       auto const stats_reply = secure_channel_detail::read<
         net::ofp::v10::protocol::ofp_stats_reply
         >(first);
-      using stats_reply_list = net::ofp::v10::default_stats_reply_list;
-      switch (stats_reply.type) {
-
-#     define CANARD_NETWORK_OPENFLOW_V10_STATS_REPLY_CASE(z, N, _) \
-      using msg ## N = std::tuple_element<N, stats_reply_list>::type; \
-      case msg ## N::stats_type(): \
-        if (!msg ## N::is_valid_stats_length(stats_reply)) { \
-          throw std::runtime_error{"invalid stats length"}; \
-        } \
-        reader->handle(base_channel, msg ## N::decode(first, last)); \
-        break;
-      static_assert(
-            std::tuple_size<stats_reply_list>::value == 6
-          , "not match to the number of stats reply types");
-      BOOST_PP_REPEAT(6, CANARD_NETWORK_OPENFLOW_V10_STATS_REPLY_CASE, _)
-#     undef  CANARD_NETWORK_OPENFLOW_V10_STATS_REPLY_CASE
-
-      default:
-        break;
-      }
+      dispatch_table<
+          handle_message_detail::stats_reply_traits
+        , handle_message_detail::stats_reply_list, MessageList
+      >::dispatch(
+          stats_reply.type, reader, base_channel, stats_reply, first, last);
     }
   };
 
+  using handle_message = basic_handle_message<>;
+
+  // The handler can restrict the dispatched messages by the message_list
+  // member type, e.g. std::tuple<v10::messages::packet_in>, or by returning
+  // ignored_message from the handle overloads of the unused messages.
   template <class ControllerHandler, class Socket>
-  using secure_channel
-    = secure_channel_reader<handle_message, ControllerHandler, Socket>;
+  using secure_channel = secure_channel_reader<
+      basic_handle_message<
+        detail::handled_message_list_t<
+            ControllerHandler
+          , std::shared_ptr<controller::secure_channel<Socket>>
+          , handle_message_detail::all_message_list
+          , handle_message_detail::decoded_message_t
+        >
+      >
+    , ControllerHandler, Socket
+  >;
 
   struct version
   {
@@ -0,0 +1,35 @@
+#ifndef CANARD_NETWORK_OPENFLOW_V13_FLOW_MOD_BATCH_DECORATOR_HPP
+#define CANARD_NETWORK_OPENFLOW_V13_FLOW_MOD_BATCH_DECORATOR_HPP
+
+#include <canard/net/ofp/controller/flow_mod_batch_decorator.hpp>
+#include <canard/net/ofp/v13/messages.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+namespace v13 {
+
+  namespace flow_mod_batch_decorator_detail {
+
+    struct protocol
+    {
+      using barrier_request = net::ofp::v13::messages::barrier_request;
+      using barrier_reply = net::ofp::v13::messages::barrier_reply;
+      using error = net::ofp::v13::messages::error;
+    };
+
+  } // namespace flow_mod_batch_decorator_detail
+
+  template <class Base>
+  using flow_mod_batch_decorator = basic_flow_mod_batch_decorator<
+    flow_mod_batch_decorator_detail::protocol, Base
+  >;
+
+} // namespace v13
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_V13_FLOW_MOD_BATCH_DECORATOR_HPP
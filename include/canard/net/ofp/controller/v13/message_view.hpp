@@ -0,0 +1,369 @@
+#ifndef CANARD_NETWORK_OPENFLOW_V13_MESSAGE_VIEW_HPP
+#define CANARD_NETWORK_OPENFLOW_V13_MESSAGE_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <boost/range/iterator_range.hpp>
+#include <canard/net/ofp/controller/message_view.hpp>
+#include <canard/net/ofp/v13/messages.hpp>
+#include <canard/net/ofp/v13/openflow.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+namespace v13 {
+
+  namespace message_view_detail {
+
+    template <class T, class Tuple>
+    struct is_contained;
+
+    template <class T>
+    struct is_contained<T, std::tuple<>>
+      : std::false_type
+    {};
+
+    template <class T, class U, class... Us>
+    struct is_contained<T, std::tuple<U, Us...>>
+      : std::conditional<
+            std::is_same<T, U>::value
+          , std::true_type
+          , is_contained<T, std::tuple<Us...>>
+        >::type
+    {};
+
+    template <class Message>
+    using is_multipart_reply = is_contained<
+      Message, net::ofp::v13::default_multipart_reply_list
+    >;
+
+    constexpr auto match_offset_of_packet_in() noexcept
+      -> std::size_t
+    {
+      return offsetof(net::ofp::v13::protocol::ofp_packet_in, match);
+    }
+
+    constexpr auto match_offset_of_flow_removed() noexcept
+      -> std::size_t
+    {
+      return offsetof(net::ofp::v13::protocol::ofp_flow_removed, match);
+    }
+
+    constexpr auto padded_length(std::uint16_t const length) noexcept
+      -> std::size_t
+    {
+      return (std::size_t{length} + 7) / 8 * 8;
+    }
+
+  } // namespace message_view_detail
+
+  template <class Message, class = void>
+  class message_view;
+
+  template <>
+  class message_view<net::ofp::v13::messages::packet_in>
+    : public basic_message_view<net::ofp::v13::messages::packet_in>
+  {
+    using raw_ofp_type = net::ofp::v13::protocol::ofp_packet_in;
+
+  public:
+    using range_type = boost::iterator_range<unsigned char const*>;
+
+    using basic_message_view::basic_message_view;
+
+    auto buffer_id() const noexcept
+      -> std::uint32_t
+    {
+      return field<std::uint32_t>(offsetof(raw_ofp_type, buffer_id));
+    }
+
+    auto total_length() const noexcept
+      -> std::uint16_t
+    {
+      return field<std::uint16_t>(offsetof(raw_ofp_type, total_len));
+    }
+
+    auto reason() const noexcept
+      -> std::uint8_t
+    {
+      return field<std::uint8_t>(offsetof(raw_ofp_type, reason));
+    }
+
+    auto table_id() const noexcept
+      -> std::uint8_t
+    {
+      return field<std::uint8_t>(offsetof(raw_ofp_type, table_id));
+    }
+
+    auto cookie() const noexcept
+      -> std::uint64_t
+    {
+      return field<std::uint64_t>(offsetof(raw_ofp_type, cookie));
+    }
+
+    auto in_port() const noexcept
+      -> std::uint32_t
+    {
+      constexpr auto offset = message_view_detail::match_offset_of_packet_in();
+      auto it = begin_at(offset + offsetof(
+            net::ofp::v13::protocol::ofp_match, oxm_fields));
+      auto const last = begin_at(offset + match_length());
+      while (it + sizeof(std::uint32_t) <= last) {
+        auto const oxm_header = secure_channel_detail::read<std::uint32_t>(it);
+        auto const oxm_class = std::uint16_t(oxm_header >> 16);
+        auto const oxm_field = std::uint8_t((oxm_header >> 9) & 0x7f);
+        auto const oxm_length = std::uint8_t(oxm_header & 0xff);
+        if (oxm_class == net::ofp::v13::protocol::OFPXMC_OPENFLOW_BASIC
+            && oxm_field == net::ofp::v13::protocol::OFPXMT_OFB_IN_PORT
+            && oxm_length == sizeof(std::uint32_t)) {
+          return secure_channel_detail::read<std::uint32_t>(
+              it + sizeof(std::uint32_t));
+        }
+        it += sizeof(std::uint32_t) + oxm_length;
+      }
+      return 0;
+    }
+
+    auto match_length() const noexcept
+      -> std::uint16_t
+    {
+      return field<std::uint16_t>(
+            message_view_detail::match_offset_of_packet_in()
+          + offsetof(net::ofp::v13::protocol::ofp_match, length));
+    }
+
+    auto frame() const noexcept
+      -> range_type
+    {
+      constexpr auto pad_length = 2;
+      return range_type{
+          begin_at(message_view_detail::match_offset_of_packet_in()
+                 + message_view_detail::padded_length(match_length())
+                 + pad_length)
+        , end()
+      };
+    }
+
+    auto frame_length() const noexcept
+      -> std::size_t
+    {
+      return frame().size();
+    }
+  };
+
+  template <>
+  class message_view<net::ofp::v13::messages::flow_removed>
+    : public basic_message_view<net::ofp::v13::messages::flow_removed>
+  {
+    using raw_ofp_type = net::ofp::v13::protocol::ofp_flow_removed;
+
+  public:
+    using basic_message_view::basic_message_view;
+
+    auto cookie() const noexcept
+      -> std::uint64_t
+    {
+      return field<std::uint64_t>(offsetof(raw_ofp_type, cookie));
+    }
+
+    auto priority() const noexcept
+      -> std::uint16_t
+    {
+      return field<std::uint16_t>(offsetof(raw_ofp_type, priority));
+    }
+
+    auto reason() const noexcept
+      -> std::uint8_t
+    {
+      return field<std::uint8_t>(offsetof(raw_ofp_type, reason));
+    }
+
+    auto table_id() const noexcept
+      -> std::uint8_t
+    {
+      return field<std::uint8_t>(offsetof(raw_ofp_type, table_id));
+    }
+
+    auto duration_sec() const noexcept
+      -> std::uint32_t
+    {
+      return field<std::uint32_t>(offsetof(raw_ofp_type, duration_sec));
+    }
+
+    auto duration_nsec() const noexcept
+      -> std::uint32_t
+    {
+      return field<std::uint32_t>(offsetof(raw_ofp_type, duration_nsec));
+    }
+
+    auto idle_timeout() const noexcept
+      -> std::uint16_t
+    {
+      return field<std::uint16_t>(offsetof(raw_ofp_type, idle_timeout));
+    }
+
+    auto hard_timeout() const noexcept
+      -> std::uint16_t
+    {
+      return field<std::uint16_t>(offsetof(raw_ofp_type, hard_timeout));
+    }
+
+    auto packet_count() const noexcept
+      -> std::uint64_t
+    {
+      return field<std::uint64_t>(offsetof(raw_ofp_type, packet_count));
+    }
+
+    auto byte_count() const noexcept
+      -> std::uint64_t
+    {
+      return field<std::uint64_t>(offsetof(raw_ofp_type, byte_count));
+    }
+
+    auto match_length() const noexcept
+      -> std::uint16_t
+    {
+      return field<std::uint16_t>(
+            message_view_detail::match_offset_of_flow_removed()
+          + offsetof(net::ofp::v13::protocol::ofp_match, length));
+    }
+  };
+
+  template <class MultipartReply>
+  class message_view<
+      MultipartReply
+    , typename std::enable_if<
+        message_view_detail::is_multipart_reply<MultipartReply>::value
+      >::type
+  >
+    : public basic_message_view<MultipartReply>
+  {
+    using raw_ofp_type = net::ofp::v13::protocol::ofp_multipart_reply;
+
+  public:
+    using range_type = boost::iterator_range<unsigned char const*>;
+
+    using basic_message_view<MultipartReply>::basic_message_view;
+
+    auto multipart_type() const noexcept
+      -> std::uint16_t
+    {
+      return this->template field<std::uint16_t>(offsetof(raw_ofp_type, type));
+    }
+
+    auto flags() const noexcept
+      -> std::uint16_t
+    {
+      return this->template field<std::uint16_t>(offsetof(raw_ofp_type, flags));
+    }
+
+    auto is_more() const noexcept
+      -> bool
+    {
+      return flags() & net::ofp::v13::protocol::OFPMPF_REPLY_MORE;
+    }
+
+    auto body() const noexcept
+      -> range_type
+    {
+      return range_type{this->begin_at(sizeof(raw_ofp_type)), this->end()};
+    }
+
+    auto body_length() const noexcept
+      -> std::size_t
+    {
+      return body().size();
+    }
+  };
+
+  namespace message_view_detail {
+
+    template <class Message>
+    auto is_viewable_impl(Message const*)
+      -> decltype(sizeof(message_view<Message>), std::true_type{});
+    auto is_viewable_impl(...)
+      -> std::false_type;
+
+    template <class Message>
+    using is_viewable = decltype(
+        is_viewable_impl(static_cast<Message const*>(nullptr)));
+
+    // The fixed part and the match must be in the message, as the views
+    // read them without bounds checking.
+    inline auto is_valid(
+        message_view<net::ofp::v13::messages::packet_in> const& msg) noexcept
+      -> bool
+    {
+      constexpr auto offset = match_offset_of_packet_in();
+      constexpr auto pad_length = 2;
+      return msg.length() >= sizeof(net::ofp::v13::protocol::ofp_packet_in)
+          && msg.match_length()
+             >= offsetof(net::ofp::v13::protocol::ofp_match, oxm_fields)
+          && offset + padded_length(msg.match_length()) + pad_length
+             <= msg.length();
+    }
+
+    inline auto is_valid(
+        message_view<net::ofp::v13::messages::flow_removed> const& msg) noexcept
+      -> bool
+    {
+      constexpr auto offset = match_offset_of_flow_removed();
+      return msg.length() >= sizeof(net::ofp::v13::protocol::ofp_flow_removed)
+          && msg.match_length()
+             >= offsetof(net::ofp::v13::protocol::ofp_match, oxm_fields)
+          && offset + padded_length(msg.match_length()) <= msg.length();
+    }
+
+    template <class MultipartReply>
+    auto is_valid(message_view<MultipartReply> const& msg) noexcept
+      -> bool
+    {
+      return msg.length()
+          >= sizeof(net::ofp::v13::protocol::ofp_multipart_reply);
+    }
+
+    template <class Message>
+    auto decode_message(
+          unsigned char const* first, unsigned char const* const last
+        , std::true_type)
+      -> message_view<Message>
+    {
+      auto const msg = message_view<Message>{first, last};
+      if (!message_view_detail::is_valid(msg)) {
+        throw std::runtime_error{"invalid message length"};
+      }
+      return msg;
+    }
+
+    template <class Message>
+    auto decode_message(
+          unsigned char const* first, unsigned char const* const last
+        , std::false_type)
+      -> Message
+    {
+      return Message::decode(first, last);
+    }
+
+    template <class Message>
+    auto decode_message(
+        unsigned char const* const first, unsigned char const* const last)
+      -> decltype(message_view_detail::decode_message<Message>(
+            first, last, is_viewable<Message>{}))
+    {
+      return message_view_detail::decode_message<Message>(
+          first, last, is_viewable<Message>{});
+    }
+
+  } // namespace message_view_detail
+
+} // namespace v13
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_V13_MESSAGE_VIEW_HPP
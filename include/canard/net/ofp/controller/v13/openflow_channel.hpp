@@ -1,10 +1,17 @@
 #ifndef CANARD_NETWORK_OPENFLOW_V13_CHANNLE_HPP
 #define CANARD_NETWORK_OPENFLOW_V13_CHANNLE_HPP
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <tuple>
-#include <boost/preprocessor/repeat.hpp>
+#include <utility>
+#include <canard/integer_sequence.hpp>
+#include <canard/net/ofp/controller/detail/read.hpp>
+#include <canard/net/ofp/controller/dispatch_table.hpp>
+#include <canard/net/ofp/controller/ignored_message.hpp>
 #include <canard/net/ofp/controller/secure_channel_reader.hpp>
+#include <canard/net/ofp/controller/v13/message_view.hpp>
 #include <canard/net/ofp/v13/detail/byteorder.hpp>
 #include <canard/net/ofp/v13/messages.hpp>
 #include <canard/net/ofp/v13/openflow.hpp>
@@ -15,9 +22,123 @@ namespace ofp {
 namespace controller {
 namespace v13 {
 
-  struct handle_message
+  namespace handle_message_detail {
+
+    template <class Tuple, class Indices>
+    struct prefix_impl;
+
+    template <class Tuple, std::size_t... Ints>
+    struct prefix_impl<Tuple, canard::index_sequence<Ints...>>
+    {
+      using type
+        = std::tuple<typename std::tuple_element<Ints, Tuple>::type...>;
+    };
+
+    // The last two messages of default_switch_message_list are not
+    // dispatched.
+    static_assert(
+          std::tuple_size<net::ofp::v13::default_switch_message_list>::value
+          == 12
+        , "not match to the number of message types");
+    using switch_message_list = typename prefix_impl<
+        net::ofp::v13::default_switch_message_list
+      , canard::make_index_sequence<10>
+    >::type;
+
+    using multipart_reply_list = net::ofp::v13::default_multipart_reply_list;
+    static_assert(
+          std::tuple_size<multipart_reply_list>::value == 14
+        , "not match to the number of multipart reply types");
+
+    using all_message_list = decltype(std::tuple_cat(
+          std::declval<switch_message_list>()
+        , std::declval<multipart_reply_list>()));
+
+    template <class Message>
+    using decoded_message_t = decltype(
+        message_view_detail::decode_message<Message>(nullptr, nullptr));
+
+    template <class HeaderType>
+    struct decode_traits
+    {
+      using header_type = HeaderType;
+
+      template <class Message, class Reader, class BaseChannel>
+      static void handle(
+            Reader* const reader, BaseChannel const& base_channel
+          , header_type const&
+          , unsigned char const* const first
+          , unsigned char const* const last)
+      {
+        detail::reader_access::handle(
+            reader, base_channel, decode<Message>(reader, first, last));
+      }
+
+      // Both the eager decoding and the validation of the views throw
+      // for malformed messages.
+      template <class Message, class Reader>
+      static auto decode(
+            Reader* const reader
+          , unsigned char const* const first
+          , unsigned char const* const last)
+        -> decoded_message_t<Message>
+      {
+        try {
+          return message_view_detail::decode_message<Message>(first, last);
+        }
+        catch (...) {
+          detail::reader_access::handle_decode_error(reader);
+          throw;
+        }
+      }
+
+      template <class Reader, class BaseChannel>
+      static void handle_unknown(
+            Reader* const reader, BaseChannel const&
+          , header_type const&
+          , unsigned char const*, unsigned char const*)
+      {
+        detail::reader_access::handle_decode_error(reader);
+      }
+    };
+
+    struct message_traits
+      : decode_traits<net::ofp::v13::protocol::ofp_header>
+    {
+      template <class Message>
+      static constexpr auto key() noexcept
+        -> std::size_t
+      {
+        return Message::message_type;
+      }
+    };
+
+    struct multipart_reply_traits
+      : decode_traits<net::ofp::v13::protocol::ofp_multipart_reply>
+    {
+      template <class Message>
+      static constexpr auto key() noexcept
+        -> std::size_t
+      {
+        return Message::multipart_type_value;
+      }
+    };
+
+  } // namespace handle_message_detail
+
+  // Dispatches the messages in MessageList, and drops the other messages
+  // without decoding them.
+  template <class MessageList = handle_message_detail::all_message_list>
+  struct basic_handle_message
   {
     using header_type = net::ofp::v13::protocol::ofp_header;
+    using message_list = MessageList;
+
+    static_assert(
+          detail::is_known_message_list<
+            MessageList, handle_message_detail::all_message_list
+          >::value
+        , "message_list contains messages which are not dispatched");
 
     template <class Reader, class BaseChannel>
     void operator()(
@@ -26,31 +147,19 @@ namespace v13 {
         , unsigned char const* first
         , unsigned char const* const last) const
     {
-      using message_list = net::ofp::v13::default_switch_message_list;
-      switch (header.type) {
-
-#     define CANARD_NETWORK_OPENFLOW_V13_MESSAGES_CASE(z, N, _) \
-      using msg ## N = std::tuple_element<N, message_list>::type; \
-      case msg ## N::message_type: \
-        reader->handle(base_channel, msg ## N::decode(first, last)); \
-        break;
-      static_assert(
-            std::tuple_size<message_list>::value == 12
-          , "not match to the number of message types");
-      BOOST_PP_REPEAT(10, CANARD_NETWORK_OPENFLOW_V13_MESSAGES_CASE, _)
-#     undef  CANARD_NETWORK_OPENFLOW_V13_MESSAGES_CASE
-
-      case net::ofp::v13::protocol::OFPT_MULTIPART_REPLY:
+      if (header.type == net::ofp::v13::protocol::OFPT_MULTIPART_REPLY) {
         if (header.length < sizeof(net::ofp::v13::protocol::ofp_multipart_reply)) {
           // TODO needs error handling
-          break;
+          reader->handle_decode_error();
+          return;
         }
         handle_multipart_reply(reader, base_channel, first, last);
-        break;
-
-      default:
-        break;
+        return;
       }
+      dispatch_table<
+          handle_message_detail::message_traits
+        , handle_message_detail::switch_message_list, MessageList
+      >::dispatch(header.type, reader, base_channel, header, first, last);
     }
 
     template <class Reader, class BaseChannel>
@@ -62,29 +171,31 @@ namespace v13 {
       auto const multipart_reply = secure_channel_detail::read<
         net::ofp::v13::protocol::ofp_multipart_reply
       >(first);
-      using multipart_reply_list = net::ofp::v13::default_multipart_reply_list;
-      switch (multipart_reply.type) {
-
-#     define CANARD_NETWORK_OPENFLOW_V13_MULTIPART_REPLY_CASE(z, N, _) \
-      using msg ## N = std::tuple_element<N, multipart_reply_list>::type; \
-      case msg ## N::multipart_type_value: \
-        reader->handle(base_channel, msg ## N::decode(first, last)); \
-        break;
-      static_assert(
-            std::tuple_size<multipart_reply_list>::value == 14
-          , "not match to the number of multipart reply types");
-      BOOST_PP_REPEAT(14, CANARD_NETWORK_OPENFLOW_V13_MULTIPART_REPLY_CASE, _)
-#     undef  CANARD_NETWORK_OPENFLOW_V13_MULTIPART_REPLY_CASE
-
-      default:
-        break;
-      }
+      dispatch_table<
+          handle_message_detail::multipart_reply_traits
+        , handle_message_detail::multipart_reply_list, MessageList
+      >::dispatch(
+          multipart_reply.type, reader, base_channel, multipart_reply
+        , first, last);
     }
   };
 
+  using handle_message = basic_handle_message<>;
+
+  // The handler can restrict the dispatched messages by the message_list
+  // member type, e.g. std::tuple<v13::messages::packet_in>, or by returning
+  // ignored_message from the handle overloads of the unused messages.
   template <class ControllerHandler, class Socket>
-  using openflow_channel
-    = secure_channel_reader<handle_message, ControllerHandler, Socket>;
+  using openflow_channel = secure_channel_reader<
+      basic_handle_message<
+        detail::handled_message_list_t<
+            ControllerHandler, std::shared_ptr<secure_channel<Socket>>
+          , handle_message_detail::all_message_list
+          , handle_message_detail::decoded_message_t
+        >
+      >
+    , ControllerHandler, Socket
+  >;
 
   struct version
   {
@@ -0,0 +1,331 @@
+#ifndef CANARD_NETWORK_OPENFLOW_WRITE_BACKPRESSURE_HPP
+#define CANARD_NETWORK_OPENFLOW_WRITE_BACKPRESSURE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/system/error_code.hpp>
+#include <canard/asio/asio_handler_hook_propagation.hpp>
+#include <canard/asio/detail/bind_handler.hpp>
+#include <canard/asio/recycling_handler.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+
+  // Limits of the bytes queued to a channel and not yet written.
+  // The channel becomes unwritable when the queued bytes reach the high
+  // water mark, and writable again when they fall to the low water mark.
+  // Backpressure is disabled unless high_water_mark is set.
+  class write_backpressure_options
+  {
+  public:
+    write_backpressure_options() noexcept
+      : high_water_mark_{0}
+      , low_water_mark_{0}
+      , drop_packet_outs_{false}
+    {
+    }
+
+    auto is_enabled() const noexcept
+      -> bool
+    {
+      return high_water_mark_ != 0;
+    }
+
+    auto high_water_mark() const noexcept
+      -> std::size_t
+    {
+      return high_water_mark_;
+    }
+
+    auto high_water_mark(std::size_t const bytes) noexcept
+      -> write_backpressure_options&
+    {
+      high_water_mark_ = bytes;
+      return *this;
+    }
+
+    auto low_water_mark() const noexcept
+      -> std::size_t
+    {
+      return low_water_mark_;
+    }
+
+    auto low_water_mark(std::size_t const bytes) noexcept
+      -> write_backpressure_options&
+    {
+      low_water_mark_ = bytes;
+      return *this;
+    }
+
+    auto drop_packet_outs() const noexcept
+      -> bool
+    {
+      return drop_packet_outs_;
+    }
+
+    // Drops the packet_outs sent while the channel is unwritable.
+    // Their handlers are called with boost::asio::error::no_buffer_space.
+    // The packet_outs in the messages sent together by async_send_all or
+    // async_send_encoded are removed from the written bytes, and the handler
+    // is called with no_buffer_space only if no message remains.
+    auto drop_packet_outs(bool const enabled) noexcept
+      -> write_backpressure_options&
+    {
+      drop_packet_outs_ = enabled;
+      return *this;
+    }
+
+  private:
+    std::size_t high_water_mark_;
+    std::size_t low_water_mark_;
+    bool drop_packet_outs_;
+  };
+
+  namespace detail {
+
+    // Queued bytes of a channel and the handlers waiting for the channel
+    // to become writable. The bytes are added by any thread and released
+    // by the write completions. Waiting is done in the strand of the channel.
+    class write_backlog
+      : public std::enable_shared_from_this<write_backlog>
+    {
+      // OFPT_PACKET_OUT of both OpenFlow 1.0 and 1.3.
+      static constexpr std::uint8_t packet_out_type = 13;
+
+    public:
+      write_backlog(
+            boost::asio::io_service& io_service
+          , boost::asio::io_service::strand strand
+          , write_backpressure_options const& options)
+        : options_(options)
+        , strand_(std::move(strand))
+        , timer_{io_service}
+        , bytes_{0}
+        , is_blocked_{false}
+        , is_closed_{false}
+      {
+        timer_.expires_at(boost::asio::steady_timer::time_point::max());
+      }
+
+      auto bytes() const noexcept
+        -> std::size_t
+      {
+        return bytes_.load(std::memory_order_relaxed);
+      }
+
+      auto is_writable() const noexcept
+        -> bool
+      {
+        return !is_blocked_.load(std::memory_order_relaxed);
+      }
+
+      auto is_dropping() const noexcept
+        -> bool
+      {
+        return options_.drop_packet_outs() && !is_writable();
+      }
+
+      auto should_drop(std::uint8_t const type) const noexcept
+        -> bool
+      {
+        return type == packet_out_type && is_dropping();
+      }
+
+      // Removes the packet_outs to be dropped from the messages encoded
+      // back to back, and returns the number of the removed messages.
+      auto remove_dropped(std::vector<unsigned char>& bytes) const
+        -> std::size_t
+      {
+        if (!is_dropping()) {
+          return 0;
+        }
+        auto num_dropped = std::size_t{0};
+        auto first = bytes.begin();
+        auto out = first;
+        while (bytes.end() - first >= 4) {
+          auto const length = std::size_t((first[2] << 8) | first[3]);
+          if (length == 0 || std::size_t(bytes.end() - first) < length) {
+            break;
+          }
+          auto const next = first + length;
+          if (first[1] == packet_out_type) {
+            ++num_dropped;
+          }
+          else {
+            out = std::copy(first, next, out);
+          }
+          first = next;
+        }
+        out = std::copy(first, bytes.end(), out);
+        bytes.erase(out, bytes.end());
+        return num_dropped;
+      }
+
+      void add(std::size_t const bytes) noexcept
+      {
+        auto const queued
+          = bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        if (options_.is_enabled() && queued >= options_.high_water_mark()) {
+          is_blocked_.store(true, std::memory_order_relaxed);
+        }
+      }
+
+      void release(std::size_t const bytes)
+      {
+        auto const queued
+          = bytes_.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+        if (queued <= options_.low_water_mark()
+            && is_blocked_.exchange(false, std::memory_order_relaxed)) {
+          wake_waiters();
+        }
+      }
+
+      // Must be called in the strand.
+      template <class WaitHandler>
+      void async_wait_writable(WaitHandler&& handler)
+      {
+        if (is_closed_) {
+          strand_.post(canard::detail::bind(
+                std::forward<WaitHandler>(handler)
+              , boost::system::error_code{
+                  boost::asio::error::operation_aborted}));
+        }
+        else if (is_writable()) {
+          strand_.post(canard::detail::bind(
+                std::forward<WaitHandler>(handler)
+              , boost::system::error_code{}));
+        }
+        else {
+          timer_.async_wait(strand_.wrap(wait_handler<
+              typename std::decay<WaitHandler>::type
+          >{shared_from_this(), std::forward<WaitHandler>(handler)}));
+        }
+      }
+
+      void close()
+      {
+        auto self = shared_from_this();
+        strand_.dispatch(canard::make_recycling_handler([self]{
+            self->is_closed_ = true;
+            auto ignore = boost::system::error_code{};
+            self->timer_.cancel(ignore);
+        }));
+      }
+
+    private:
+      void wake_waiters()
+      {
+        auto self = shared_from_this();
+        strand_.dispatch(canard::make_recycling_handler([self]{
+            auto ignore = boost::system::error_code{};
+            self->timer_.cancel(ignore);
+        }));
+      }
+
+      template <class WaitHandler>
+      struct wait_handler
+        : canard::asio_handler_hook_propagation<wait_handler<WaitHandler>>
+      {
+        template <class Handler>
+        wait_handler(std::shared_ptr<write_backlog> const& b, Handler&& h)
+          : backlog_(b)
+          , handler_(std::forward<Handler>(h))
+        {
+        }
+
+        void operator()(boost::system::error_code const&)
+        {
+          if (backlog_->is_closed_) {
+            handler_(boost::system::error_code{
+                boost::asio::error::operation_aborted});
+          }
+          else {
+            handler_(boost::system::error_code{});
+          }
+        }
+
+        auto handler() noexcept
+          -> WaitHandler&
+        {
+          return handler_;
+        }
+
+        std::shared_ptr<write_backlog> backlog_;
+        WaitHandler handler_;
+      };
+
+    private:
+      write_backpressure_options options_;
+      boost::asio::io_service::strand strand_;
+      boost::asio::steady_timer timer_;
+      std::atomic<std::size_t> bytes_;
+      std::atomic<bool> is_blocked_;
+      bool is_closed_;
+    };
+
+    // Write handler which releases the written bytes from the backlog.
+    template <class WriteHandler>
+    struct backlog_release_handler
+      : canard::asio_handler_hook_propagation<
+          backlog_release_handler<WriteHandler>
+        >
+    {
+      template <class Handler>
+      backlog_release_handler(
+            std::shared_ptr<write_backlog> backlog, std::size_t const bytes
+          , Handler&& handler)
+        : backlog_(std::move(backlog))
+        , bytes_(bytes)
+        , handler_(std::forward<Handler>(handler))
+      {
+      }
+
+      auto handler() noexcept
+        -> WriteHandler&
+      {
+        return handler_;
+      }
+
+      template <class... Args>
+      void operator()(Args&&... args)
+      {
+        backlog_->release(bytes_);
+        handler_(std::forward<Args>(args)...);
+      }
+
+      std::shared_ptr<write_backlog> backlog_;
+      std::size_t bytes_;
+      WriteHandler handler_;
+    };
+
+    template <class WriteHandler>
+    auto make_backlog_release_handler(
+          std::shared_ptr<write_backlog> backlog, std::size_t const bytes
+        , WriteHandler&& handler)
+      -> backlog_release_handler<typename std::decay<WriteHandler>::type>
+    {
+      return backlog_release_handler<typename std::decay<WriteHandler>::type>{
+        std::move(backlog), bytes, std::forward<WriteHandler>(handler)
+      };
+    }
+
+  } // namespace detail
+
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_WRITE_BACKPRESSURE_HPP
@@ -0,0 +1,196 @@
+#ifndef CANARD_NETWORK_OPENFLOW_WRITE_COALESCING_HPP
+#define CANARD_NETWORK_OPENFLOW_WRITE_COALESCING_HPP
+
+#include <cstddef>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <boost/asio/buffer.hpp>
+#include <canard/asio/shared_buffer.hpp>
+
+namespace canard {
+namespace net {
+namespace ofp {
+namespace controller {
+
+  // Corking policy of the channel write path.
+  // Messages sent without a completion handler are buffered and written
+  // together when one of the enabled flush conditions is met.
+  // Coalescing is disabled unless flush_at_handler_exit or max_delay is set.
+  // With flush_at_handler_exit alone, only the messages sent while the
+  // channel dispatches the received messages are held, and the others
+  // are written at once.
+  class write_coalescing_options
+  {
+  public:
+    write_coalescing_options() noexcept
+      : flush_threshold_{64 * 1024}
+      , flush_at_handler_exit_{false}
+      , max_delay_{0}
+    {
+    }
+
+    auto is_enabled() const noexcept
+      -> bool
+    {
+      return flush_at_handler_exit_ || max_delay_.count() != 0;
+    }
+
+    auto flush_threshold() const noexcept
+      -> std::size_t
+    {
+      return flush_threshold_;
+    }
+
+    auto flush_threshold(std::size_t const threshold) noexcept
+      -> write_coalescing_options&
+    {
+      flush_threshold_ = threshold;
+      return *this;
+    }
+
+    auto flush_at_handler_exit() const noexcept
+      -> bool
+    {
+      return flush_at_handler_exit_;
+    }
+
+    auto flush_at_handler_exit(bool const enabled) noexcept
+      -> write_coalescing_options&
+    {
+      flush_at_handler_exit_ = enabled;
+      return *this;
+    }
+
+    auto max_delay() const noexcept
+      -> std::chrono::microseconds
+    {
+      return max_delay_;
+    }
+
+    auto max_delay(std::chrono::microseconds const delay) noexcept
+      -> write_coalescing_options&
+    {
+      max_delay_ = delay;
+      return *this;
+    }
+
+  private:
+    std::size_t flush_threshold_;
+    bool flush_at_handler_exit_;
+    std::chrono::microseconds max_delay_;
+  };
+
+  namespace detail {
+
+    // ConstBufferSequence which owns the leading part of a shared buffer.
+    class coalesced_buffer
+    {
+    public:
+      using value_type = boost::asio::const_buffer;
+      using const_iterator = boost::asio::const_buffer const*;
+
+      coalesced_buffer(canard::shared_buffer buffer, std::size_t const size)
+        : buffer_(std::move(buffer))
+        , view_{buffer_.data(), size}
+      {
+      }
+
+      auto begin() const noexcept
+        -> const_iterator
+      {
+        return &view_;
+      }
+
+      auto end() const noexcept
+        -> const_iterator
+      {
+        return &view_ + 1;
+      }
+
+    private:
+      canard::shared_buffer buffer_;
+      boost::asio::const_buffer view_;
+    };
+
+    // Accumulates encoded messages until the channel flushes them.
+    // Must be used in the strand of the channel.
+    class write_coalescer
+    {
+    public:
+      explicit write_coalescer(write_coalescing_options const& options)
+        : options_(options)
+        , buffer_{}
+        , capacity_{0}
+        , size_{0}
+      {
+      }
+
+      auto options() const noexcept
+        -> write_coalescing_options const&
+      {
+        return options_;
+      }
+
+      auto empty() const noexcept
+        -> bool
+      {
+        return size_ == 0;
+      }
+
+      auto size() const noexcept
+        -> std::size_t
+      {
+        return size_;
+      }
+
+      auto fits(std::size_t const length) const noexcept
+        -> bool
+      {
+        return size_ == 0 || size_ + length <= capacity_;
+      }
+
+      auto is_full() const noexcept
+        -> bool
+      {
+        return size_ >= options_.flush_threshold();
+      }
+
+      template <class ConstBufferSequence>
+      void append(ConstBufferSequence const& buffers)
+      {
+        auto const length = boost::asio::buffer_size(buffers);
+        if (capacity_ < size_ + length) {
+          capacity_ = std::max(options_.flush_threshold(), length);
+          buffer_.resize(capacity_);
+        }
+        size_ += boost::asio::buffer_copy(
+              boost::asio::buffer(buffer_.data() + size_, length)
+            , buffers);
+      }
+
+      auto take()
+        -> coalesced_buffer
+      {
+        auto buffer = coalesced_buffer{buffer_, size_};
+        buffer_ = canard::shared_buffer{};
+        capacity_ = 0;
+        size_ = 0;
+        return buffer;
+      }
+
+    private:
+      write_coalescing_options options_;
+      canard::shared_buffer buffer_;
+      std::size_t capacity_;
+      std::size_t size_;
+    };
+
+  } // namespace detail
+
+} // namespace controller
+} // namespace ofp
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_OPENFLOW_WRITE_COALESCING_HPP
@@ -0,0 +1,397 @@
+#ifndef CANARD_NETWORK_UTILS_ASYNC_LOGGER_HPP
+#define CANARD_NETWORK_UTILS_ASYNC_LOGGER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace canard {
+namespace net {
+namespace utils {
+
+  enum class log_level
+  {
+    debug, info, warning, error
+  };
+
+  inline auto to_string(log_level const level)
+    -> char const*
+  {
+    switch (level) {
+    case log_level::debug: return "debug";
+    case log_level::info: return "info";
+    case log_level::warning: return "warning";
+    case log_level::error: return "error";
+    }
+    return "unknown";
+  }
+
+  // Called only by the flusher thread of async_logger.
+  using log_sink = std::function<void(log_level, std::string const&)>;
+
+  class ostream_sink
+  {
+  public:
+    explicit ostream_sink(std::ostream& os)
+      : os_(&os)
+    {
+    }
+
+    void operator()(log_level const level, std::string const& message) const
+    {
+      *os_ << "[" << to_string(level) << "] " << message << '\n';
+      os_->flush();
+    }
+
+  private:
+    std::ostream* os_;
+  };
+
+  namespace async_logger_detail {
+
+    struct record
+    {
+      log_level level;
+      std::string message;
+    };
+
+    // Single producer single consumer queue of log records.
+    // The producer thread and the logger each release the queue when they
+    // stop using it, and the other side drops it afterwards.
+    class record_ring
+    {
+    public:
+      static constexpr std::size_t capacity = 256;
+
+      record_ring() noexcept
+        : head_{0}
+        , tail_{0}
+        , is_released_{false}
+      {
+      }
+
+      void release() noexcept
+      {
+        is_released_.store(true, std::memory_order_release);
+      }
+
+      auto is_released() const noexcept
+        -> bool
+      {
+        return is_released_.load(std::memory_order_acquire);
+      }
+
+      auto push(log_level const level, std::string&& message)
+        -> bool
+      {
+        auto const tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) == capacity) {
+          return false;
+        }
+        auto& slot = records_[tail % capacity];
+        slot.level = level;
+        slot.message = std::move(message);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+      }
+
+      template <class Function>
+      void consume_all(Function&& function)
+      {
+        auto head = head_.load(std::memory_order_relaxed);
+        auto const tail = tail_.load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+          auto& slot = records_[head % capacity];
+          function(slot.level, slot.message);
+          slot.message.clear();
+          head_.store(head + 1, std::memory_order_release);
+        }
+      }
+
+    private:
+      std::array<record, capacity> records_;
+      std::atomic<std::size_t> head_;
+      std::atomic<std::size_t> tail_;
+      std::atomic<bool> is_released_;
+    };
+
+    // Queues of a thread keyed by the logger id. The queues are released
+    // at the thread exit, so that the loggers reclaim them once drained.
+    struct thread_rings
+    {
+      using entry = std::pair<std::uint64_t, std::shared_ptr<record_ring>>;
+
+      ~thread_rings()
+      {
+        for (auto const& entry : entries) {
+          entry.second->release();
+        }
+      }
+
+      // Drops the queues released by the destroyed loggers.
+      void remove_released()
+      {
+        entries.erase(
+              std::remove_if(
+                  entries.begin(), entries.end()
+                , [](entry const& e) { return e.second->is_released(); })
+            , entries.end());
+      }
+
+      std::vector<entry> entries;
+    };
+
+    inline void format(std::ostream&)
+    {
+    }
+
+    template <class T, class... Args>
+    void format(std::ostream& os, T const& t, Args const&... args)
+    {
+      os << t;
+      async_logger_detail::format(os, args...);
+    }
+
+  } // namespace async_logger_detail
+
+  // Logger which never blocks the logging threads.
+  // Each thread appends records to its own lock-free queue, and a background
+  // thread passes them to the sink every flush interval. Records beyond
+  // max_records_per_second or a full queue are dropped, and the number of
+  // the dropped records is reported to the sink.
+  // The rate limit counts records per second of Clock.
+  // The queue of a thread is reclaimed after the thread exits.
+  template <class Clock = std::chrono::steady_clock>
+  class basic_async_logger
+  {
+    using record_ring = async_logger_detail::record_ring;
+
+  public:
+    explicit basic_async_logger(
+          log_sink sink = ostream_sink{std::clog}
+        , std::size_t const max_records_per_second = 1000
+        , std::chrono::milliseconds const flush_interval
+            = std::chrono::milliseconds{100})
+      : sink_(std::move(sink))
+      , max_records_per_second_{max_records_per_second}
+      , flush_interval_{flush_interval}
+      , id_{next_id()}
+      , level_{log_level::info}
+      , window_{0}
+      , window_records_{0}
+      , dropped_{0}
+      , stopped_{false}
+      , flusher_{}
+    {
+      flusher_ = std::thread{[this]{ run_flusher(); }};
+    }
+
+    basic_async_logger(basic_async_logger const&) = delete;
+    auto operator=(basic_async_logger const&) -> basic_async_logger& = delete;
+
+    ~basic_async_logger()
+    {
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopped_ = true;
+      }
+      condition_.notify_one();
+      flusher_.join();
+      flush();
+      for (auto const& ring : rings_) {
+        ring->release();
+      }
+    }
+
+    auto level() const noexcept
+      -> log_level
+    {
+      return level_.load(std::memory_order_relaxed);
+    }
+
+    // Records below the level are discarded without being formatted.
+    void level(log_level const level) noexcept
+    {
+      level_.store(level, std::memory_order_relaxed);
+    }
+
+    template <class... Args>
+    void log(log_level const level, Args const&... args)
+    {
+      if (level < this->level() || !acquire_rate()) {
+        return;
+      }
+      std::ostringstream os;
+      async_logger_detail::format(os, args...);
+      if (!local_ring().push(level, os.str())) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    // Number of the threads which have logged and not yet been reclaimed.
+    auto num_threads() const
+      -> std::size_t
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      return rings_.size();
+    }
+
+    template <class... Args>
+    void debug(Args const&... args)
+    {
+      log(log_level::debug, args...);
+    }
+
+    template <class... Args>
+    void info(Args const&... args)
+    {
+      log(log_level::info, args...);
+    }
+
+    template <class... Args>
+    void warning(Args const&... args)
+    {
+      log(log_level::warning, args...);
+    }
+
+    template <class... Args>
+    void error(Args const&... args)
+    {
+      log(log_level::error, args...);
+    }
+
+  private:
+    auto acquire_rate() noexcept
+      -> bool
+    {
+      if (max_records_per_second_ == 0) {
+        return true;
+      }
+      auto const now = std::chrono::duration_cast<std::chrono::seconds>(
+          Clock::now().time_since_epoch()).count();
+      auto window = window_.load(std::memory_order_relaxed);
+      if (window != now && window_.compare_exchange_strong(
+            window, now, std::memory_order_relaxed)) {
+        window_records_.store(0, std::memory_order_relaxed);
+      }
+      if (window_records_.fetch_add(1, std::memory_order_relaxed)
+          < max_records_per_second_) {
+        return true;
+      }
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    auto local_ring()
+      -> record_ring&
+    {
+      // ids are never reused, so entries of destroyed loggers never match
+      static thread_local async_logger_detail::thread_rings cache;
+      for (auto const& entry : cache.entries) {
+        if (entry.first == id_) {
+          return *entry.second;
+        }
+      }
+      cache.remove_released();
+      auto ring = std::make_shared<record_ring>();
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        rings_.push_back(ring);
+      }
+      cache.entries.emplace_back(id_, ring);
+      return *ring;
+    }
+
+    void run_flusher()
+    {
+      std::unique_lock<std::mutex> lock{mutex_};
+      while (!stopped_) {
+        condition_.wait_for(lock, flush_interval_);
+        lock.unlock();
+        flush();
+        lock.lock();
+      }
+    }
+
+    void flush()
+    {
+      auto rings = std::vector<std::shared_ptr<record_ring>>{};
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        rings = rings_;
+      }
+      auto drained = std::vector<record_ring*>{};
+      for (auto const& ring : rings) {
+        // no records are pushed after the release
+        auto const is_released = ring->is_released();
+        ring->consume_all(sink_);
+        if (is_released) {
+          drained.push_back(ring.get());
+        }
+      }
+      if (!drained.empty()) {
+        remove_rings(drained);
+      }
+      auto const dropped = dropped_.exchange(0, std::memory_order_relaxed);
+      if (dropped != 0) {
+        sink_(log_level::warning
+            , std::to_string(dropped) + " log records dropped");
+      }
+    }
+
+    void remove_rings(std::vector<record_ring*> const& drained)
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      rings_.erase(
+            std::remove_if(
+                rings_.begin(), rings_.end()
+              , [&](std::shared_ptr<record_ring> const& ring) {
+                  return std::find(drained.begin(), drained.end(), ring.get())
+                      != drained.end();
+              })
+          , rings_.end());
+    }
+
+    static auto next_id() noexcept
+      -> std::uint64_t
+    {
+      static std::atomic<std::uint64_t> id{0};
+      return id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+  private:
+    log_sink sink_;
+    std::size_t max_records_per_second_;
+    std::chrono::milliseconds flush_interval_;
+    std::uint64_t id_;
+    std::atomic<log_level> level_;
+    std::atomic<std::int64_t> window_;
+    std::atomic<std::size_t> window_records_;
+    std::atomic<std::size_t> dropped_;
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopped_;
+    std::vector<std::shared_ptr<record_ring>> rings_;
+    std::thread flusher_;
+  };
+
+  using async_logger = basic_async_logger<>;
+
+} // namespace utils
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_UTILS_ASYNC_LOGGER_HPP
@@ -0,0 +1,178 @@
+#ifndef CANARD_NETWORK_UTILS_HISTOGRAM_HPP
+#define CANARD_NETWORK_UTILS_HISTOGRAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <limits>
+
+namespace canard {
+namespace net {
+namespace utils {
+
+  // Histogram of non-negative values with log-linear bucket boundaries.
+  // Each power-of-two range [2^e, 2^(e+1)) is split into sub_bucket_count
+  // linear sub-buckets, so a bucket is at most 1/sub_bucket_count of its
+  // lower bound wide. Values below sub_bucket_count have a bucket each.
+  class histogram_snapshot
+  {
+  public:
+    static constexpr std::size_t sub_bucket_bits = 3;
+    static constexpr std::size_t sub_bucket_count
+      = std::size_t{1} << sub_bucket_bits;
+    static constexpr std::size_t bucket_count
+      = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+    histogram_snapshot() noexcept
+      : count_{0}
+      , sum_{0}
+    {
+      buckets_.fill(0);
+    }
+
+    static auto bucket_of(std::uint64_t const value) noexcept
+      -> std::size_t
+    {
+      if (value < sub_bucket_count) {
+        return value;
+      }
+      auto exponent = std::size_t{0};
+      for (auto v = value >> 1; v != 0; v >>= 1) {
+        ++exponent;
+      }
+      auto const shift = exponent - sub_bucket_bits;
+      return shift * sub_bucket_count + (value >> shift);
+    }
+
+    // Upper bound (exclusive) of values in the bucket.
+    static auto bucket_limit(std::size_t const bucket) noexcept
+      -> std::uint64_t
+    {
+      if (bucket >= bucket_count - 1) {
+        return std::numeric_limits<std::uint64_t>::max();
+      }
+      if (bucket < sub_bucket_count) {
+        return bucket + 1;
+      }
+      auto const shift = bucket / sub_bucket_count - 1;
+      auto const mantissa = bucket % sub_bucket_count + sub_bucket_count;
+      return std::uint64_t(mantissa + 1) << shift;
+    }
+
+    auto count() const noexcept
+      -> std::uint64_t
+    {
+      return count_;
+    }
+
+    auto sum() const noexcept
+      -> std::uint64_t
+    {
+      return sum_;
+    }
+
+    auto bucket(std::size_t const index) const noexcept
+      -> std::uint64_t
+    {
+      return buckets_[index];
+    }
+
+    // Upper bound of the bucket which contains the given quantile.
+    auto quantile(double const q) const noexcept
+      -> std::uint64_t
+    {
+      if (count_ == 0) {
+        return 0;
+      }
+      auto const rank = static_cast<std::uint64_t>(q * (count_ - 1)) + 1;
+      auto accumulated = std::uint64_t{0};
+      for (auto i = std::size_t{0}; i < bucket_count; ++i) {
+        accumulated += buckets_[i];
+        if (accumulated >= rank) {
+          return bucket_limit(i);
+        }
+      }
+      return bucket_limit(bucket_count - 1);
+    }
+
+    void add(std::size_t const bucket, std::uint64_t const count) noexcept
+    {
+      buckets_[bucket] += count;
+      count_ += count;
+    }
+
+    void add_sum(std::uint64_t const sum) noexcept
+    {
+      sum_ += sum;
+    }
+
+    void merge(histogram_snapshot const& other) noexcept
+    {
+      for (auto i = std::size_t{0}; i < bucket_count; ++i) {
+        buckets_[i] += other.buckets_[i];
+      }
+      count_ += other.count_;
+      sum_ += other.sum_;
+    }
+
+  private:
+    std::array<std::uint64_t, bucket_count> buckets_;
+    std::uint64_t count_;
+    std::uint64_t sum_;
+  };
+
+  // Recorded by a single thread at a time and read by any thread.
+  class histogram
+  {
+  public:
+    histogram() noexcept
+      : sum_{0}
+    {
+      for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    histogram(histogram const&) = delete;
+    auto operator=(histogram const&) -> histogram& = delete;
+
+    void record(std::uint64_t const value) noexcept
+    {
+      increment(buckets_[histogram_snapshot::bucket_of(value)], 1);
+      increment(sum_, value);
+    }
+
+    auto snapshot() const noexcept
+      -> histogram_snapshot
+    {
+      auto snapshot = histogram_snapshot{};
+      for (auto i = std::size_t{0}; i < buckets_.size(); ++i) {
+        snapshot.add(i, buckets_[i].load(std::memory_order_relaxed));
+      }
+      snapshot.add_sum(sum_.load(std::memory_order_relaxed));
+      return snapshot;
+    }
+
+  private:
+    static void increment(
+        std::atomic<std::uint64_t>& counter, std::uint64_t const value)
+      noexcept
+    {
+      counter.store(
+            counter.load(std::memory_order_relaxed) + value
+          , std::memory_order_relaxed);
+    }
+
+  private:
+    std::array<
+      std::atomic<std::uint64_t>, histogram_snapshot::bucket_count
+    > buckets_;
+    std::atomic<std::uint64_t> sum_;
+  };
+
+} // namespace utils
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_UTILS_HISTOGRAM_HPP
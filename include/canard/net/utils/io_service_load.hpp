@@ -0,0 +1,112 @@
+#ifndef CANARD_NETWORK_UTILS_IO_SERVICE_LOAD_HPP
+#define CANARD_NETWORK_UTILS_IO_SERVICE_LOAD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <boost/asio/io_service.hpp>
+
+namespace canard {
+namespace net {
+namespace utils {
+
+  // Per io_service counters of live channels and received messages.
+  // Obtained by boost::asio::use_service<io_service_load>(io_service).
+  template <class = void>
+  class basic_io_service_load
+    : public boost::asio::io_service::service
+  {
+  public:
+    static boost::asio::io_service::id id;
+
+    explicit basic_io_service_load(boost::asio::io_service& io_service)
+      : boost::asio::io_service::service(io_service)
+      , connections_{0}
+      , messages_{0}
+    {
+    }
+
+    void add_connection() noexcept
+    {
+      connections_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void remove_connection() noexcept
+    {
+      connections_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void add_messages(std::size_t const count) noexcept
+    {
+      messages_.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    auto connections() const noexcept
+      -> std::size_t
+    {
+      return connections_.load(std::memory_order_relaxed);
+    }
+
+    auto messages() const noexcept
+      -> std::uint64_t
+    {
+      return messages_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    void shutdown_service() override
+    {
+    }
+
+  private:
+    std::atomic<std::size_t> connections_;
+    std::atomic<std::uint64_t> messages_;
+  };
+
+  template <class T>
+  boost::asio::io_service::id basic_io_service_load<T>::id;
+
+  using io_service_load = basic_io_service_load<>;
+
+  // Counts a connection in the io_service_load of an io_service while alive.
+  // Taken when the connection is placed on the io_service and moved to
+  // the channel, so that the connections in the handshake are counted.
+  class connection_count
+  {
+  public:
+    explicit connection_count(boost::asio::io_service& io_service)
+      : load_(&boost::asio::use_service<io_service_load>(io_service))
+    {
+      load_->add_connection();
+    }
+
+    connection_count(connection_count&& other) noexcept
+      : load_(other.load_)
+    {
+      other.load_ = nullptr;
+    }
+
+    auto operator=(connection_count const&) -> connection_count& = delete;
+
+    ~connection_count()
+    {
+      if (load_) {
+        load_->remove_connection();
+      }
+    }
+
+    auto load() const noexcept
+      -> io_service_load&
+    {
+      return *load_;
+    }
+
+  private:
+    io_service_load* load_;
+  };
+
+} // namespace utils
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_UTILS_IO_SERVICE_LOAD_HPP
@@ -18,18 +18,25 @@ namespace utils {
   class io_service_pool
   {
   public:
+    // With work stealing, any thread of the pool may run the handlers of
+    // any io_service, so each io_service is told to expect all of them.
     explicit io_service_pool(
           std::size_t const nio_services
-        , std::size_t const nthreads_per_io_srv = 1)
+        , std::size_t const nthreads_per_io_srv = 1
+        , bool const work_stealing = false)
       : index_{0}
       , nthreads_per_io_srv_{nthreads_per_io_srv}
+      , work_stealing_{work_stealing}
     {
+      auto const concurrency_hint = work_stealing
+        ? nio_services * nthreads_per_io_srv
+        : nthreads_per_io_srv;
       io_services_.reserve(nio_services);
-      futures_.reserve(thread_count());
+      futures_.reserve(nio_services * nthreads_per_io_srv);
       for (auto i = std::size_t{0}; i < nio_services; ++i) {
         io_services_.push_back(
             std::unique_ptr<boost::asio::io_service>{
-              new boost::asio::io_service{nthreads_per_io_srv}
+              new boost::asio::io_service{concurrency_hint}
             });
       }
     }
@@ -46,6 +53,12 @@ namespace utils {
       return *io_services_[next_index % io_services_.size()];
     }
 
+    auto get_io_service(std::size_t const index)
+      -> boost::asio::io_service&
+    {
+      return *io_services_[index];
+    }
+
     auto io_service_count() const noexcept
       -> std::size_t
     {
@@ -58,6 +71,12 @@ namespace utils {
       return io_services_.size() * nthreads_per_io_srv_;
     }
 
+    auto is_work_stealing() const noexcept
+      -> bool
+    {
+      return work_stealing_;
+    }
+
     template <class Func>
     void start(bool const block, Func&& func)
     {
@@ -148,6 +167,7 @@ namespace utils {
     std::vector<std::unique_ptr<boost::asio::io_service>> io_services_;
     std::atomic<std::size_t> index_;
     std::size_t nthreads_per_io_srv_;
+    bool work_stealing_;
     std::vector<std::future<void>> futures_;
     std::mutex mutex_;
   };
@@ -0,0 +1,152 @@
+#ifndef CANARD_NETWORK_UTILS_PLACEMENT_POLICY_HPP
+#define CANARD_NETWORK_UTILS_PLACEMENT_POLICY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <canard/net/utils/io_service_load.hpp>
+#include <canard/net/utils/io_service_pool.hpp>
+
+namespace canard {
+namespace net {
+namespace utils {
+
+  // Selects the io_service on which a newly accepted connection runs.
+  using placement_policy
+    = std::function<boost::asio::io_service&(io_service_pool&)>;
+
+  struct round_robin_placement
+  {
+    auto operator()(io_service_pool& pool) const
+      -> boost::asio::io_service&
+    {
+      return pool.get_io_service();
+    }
+  };
+
+  // Selects the io_service with the fewest connections.
+  // A connection is counted from its placement, so that the connections
+  // accepted back to back are spread before their handshakes complete.
+  struct least_connections_placement
+  {
+    auto operator()(io_service_pool& pool) const
+      -> boost::asio::io_service&
+    {
+      auto selected = std::size_t{0};
+      auto min_connections = std::numeric_limits<std::size_t>::max();
+      for (auto i = std::size_t{0}; i < pool.io_service_count(); ++i) {
+        auto const connections = boost::asio::use_service<io_service_load>(
+            pool.get_io_service(i)).connections();
+        if (connections < min_connections) {
+          selected = i;
+          min_connections = connections;
+        }
+      }
+      return pool.get_io_service(selected);
+    }
+  };
+
+  // Selects the io_service which received the fewest messages per second
+  // over the last sampling window.
+  // Connections placed since the last sample are charged the average
+  // per-connection rate, so that a burst of accepts is spread out.
+  class least_recent_load_placement
+  {
+    using clock = std::chrono::steady_clock;
+
+    struct state
+    {
+      std::mutex mutex;
+      clock::time_point last_sample;
+      std::vector<std::uint64_t> messages;
+      std::vector<double> rates;
+      std::vector<std::size_t> placed;
+    };
+
+  public:
+    explicit least_recent_load_placement(
+        clock::duration const window = std::chrono::seconds{1})
+      : window_{window}
+      , state_{std::make_shared<state>()}
+    {
+    }
+
+    auto operator()(io_service_pool& pool) const
+      -> boost::asio::io_service&
+    {
+      auto const count = pool.io_service_count();
+      std::lock_guard<std::mutex> lock{state_->mutex};
+      if (state_->messages.size() != count) {
+        state_->messages.assign(count, 0);
+        state_->rates.assign(count, 0.0);
+        state_->placed.assign(count, 0);
+        state_->last_sample = clock::now();
+      }
+      sample(pool);
+
+      auto total_rate = 0.0;
+      auto total_connections = std::size_t{0};
+      for (auto i = std::size_t{0}; i < count; ++i) {
+        total_rate += state_->rates[i];
+        total_connections += load_of(pool, i).connections();
+      }
+      auto const rate_per_connection
+        = total_connections == 0 ? 1.0 : total_rate / total_connections;
+
+      auto selected = std::size_t{0};
+      auto min_load = std::numeric_limits<double>::max();
+      for (auto i = std::size_t{0}; i < count; ++i) {
+        auto const load = state_->rates[i]
+                        + rate_per_connection * state_->placed[i];
+        if (load < min_load) {
+          selected = i;
+          min_load = load;
+        }
+      }
+      ++state_->placed[selected];
+      return pool.get_io_service(selected);
+    }
+
+  private:
+    static auto load_of(io_service_pool& pool, std::size_t const index)
+      -> io_service_load&
+    {
+      return boost::asio::use_service<io_service_load>(
+          pool.get_io_service(index));
+    }
+
+    void sample(io_service_pool& pool) const
+    {
+      auto const now = clock::now();
+      auto const elapsed = now - state_->last_sample;
+      if (elapsed < window_) {
+        return;
+      }
+      auto const seconds
+        = std::chrono::duration_cast<std::chrono::duration<double>>(elapsed);
+      for (auto i = std::size_t{0}; i < state_->messages.size(); ++i) {
+        auto const messages = load_of(pool, i).messages();
+        state_->rates[i]
+          = (messages - state_->messages[i]) / seconds.count();
+        state_->messages[i] = messages;
+        state_->placed[i] = 0;
+      }
+      state_->last_sample = now;
+    }
+
+  private:
+    clock::duration window_;
+    std::shared_ptr<state> state_;
+  };
+
+} // namespace utils
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_UTILS_PLACEMENT_POLICY_HPP
@@ -0,0 +1,58 @@
+#ifndef CANARD_NETWORK_UTILS_REUSE_PORT_HPP
+#define CANARD_NETWORK_UTILS_REUSE_PORT_HPP
+
+#include <cstddef>
+#include <sys/socket.h>
+
+namespace canard {
+namespace net {
+namespace utils {
+
+  // SettableSocketOption for SO_REUSEPORT.
+  // Lets several acceptors bind the same endpoint, and the kernel
+  // distributes incoming connections among them.
+  class reuse_port
+  {
+  public:
+    explicit reuse_port(bool const enabled = true) noexcept
+      : value_(enabled ? 1 : 0)
+    {
+    }
+
+    template <class Protocol>
+    auto level(Protocol const&) const noexcept
+      -> int
+    {
+      return SOL_SOCKET;
+    }
+
+    template <class Protocol>
+    auto name(Protocol const&) const noexcept
+      -> int
+    {
+      return SO_REUSEPORT;
+    }
+
+    template <class Protocol>
+    auto data(Protocol const&) const noexcept
+      -> int const*
+    {
+      return &value_;
+    }
+
+    template <class Protocol>
+    auto size(Protocol const&) const noexcept
+      -> std::size_t
+    {
+      return sizeof(value_);
+    }
+
+  private:
+    int value_;
+  };
+
+} // namespace utils
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_UTILS_REUSE_PORT_HPP
@@ -0,0 +1,526 @@
+#ifndef CANARD_NETWORK_UTILS_TIMER_WHEEL_HPP
+#define CANARD_NETWORK_UTILS_TIMER_WHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <boost/asio/basic_waitable_timer.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/handler_alloc_hook.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/wait_traits.hpp>
+#include <boost/system/error_code.hpp>
+#include <canard/asio/async_result_init.hpp>
+#include <canard/asio/detail/bind_handler.hpp>
+#include <canard/asio/recycling_handler.hpp>
+
+namespace canard {
+namespace net {
+namespace utils {
+
+  namespace timer_wheel_detail {
+
+    struct wait_op
+    {
+      using func_type = void(*)(
+          wait_op*, boost::asio::io_service*, boost::system::error_code const&);
+
+      // Posts the handler to the io_service, or only destroys it if the
+      // io_service is null.
+      void complete(
+            boost::asio::io_service* const io_service
+          , boost::system::error_code const& ec)
+      {
+        func(this, io_service, ec);
+      }
+
+      wait_op* next;
+      func_type func;
+    };
+
+    // Holds work of the io_service as a wait without expiry has no asio
+    // operation behind it.
+    template <class Handler>
+    struct wait_handler_op
+      : wait_op
+    {
+      wait_handler_op(Handler& h, boost::asio::io_service& io_service)
+        : wait_op{nullptr, &do_complete}
+        , handler(std::move(h))
+        , work(io_service)
+      {
+      }
+
+      static auto create(Handler& h, boost::asio::io_service& io_service)
+        -> wait_op*
+      {
+        using boost::asio::asio_handler_allocate;
+        auto const p = asio_handler_allocate(
+            sizeof(wait_handler_op), std::addressof(h));
+        return ::new (p) wait_handler_op(h, io_service);
+      }
+
+      static void do_complete(
+            wait_op* const base, boost::asio::io_service* const io_service
+          , boost::system::error_code const& ec)
+      {
+        auto const op = static_cast<wait_handler_op*>(base);
+        auto handler = std::move(op->handler);
+        // released after the handler is posted
+        auto const work = op->work;
+        op->~wait_handler_op();
+        using boost::asio::asio_handler_deallocate;
+        asio_handler_deallocate(
+            op, sizeof(wait_handler_op), std::addressof(handler));
+        if (io_service) {
+          io_service->post(canard::detail::bind(std::move(handler), ec));
+        }
+      }
+
+      Handler handler;
+      boost::asio::io_service::work work;
+    };
+
+    // Element of the circular list of a slot while the timer is armed.
+    struct timer_node
+    {
+      void link_before(timer_node& head) noexcept
+      {
+        prev = head.prev;
+        next = &head;
+        head.prev->next = this;
+        head.prev = this;
+      }
+
+      void unlink() noexcept
+      {
+        prev->next = next;
+        next->prev = prev;
+        prev = next = nullptr;
+      }
+
+      auto is_linked() const noexcept
+        -> bool
+      {
+        return next != nullptr;
+      }
+
+      auto take_ops() noexcept
+        -> wait_op*
+      {
+        auto const result = ops;
+        ops = nullptr;
+        return result;
+      }
+
+      timer_node* prev = nullptr;
+      timer_node* next = nullptr;
+      std::uint64_t expiry = 0;
+      wait_op* ops = nullptr;
+    };
+
+    inline auto complete_all(
+          wait_op* op, boost::asio::io_service* const io_service
+        , boost::system::error_code const& ec)
+      -> std::size_t
+    {
+      auto count = std::size_t{0};
+      while (op) {
+        auto const next = op->next;
+        op->complete(io_service, ec);
+        op = next;
+        ++count;
+      }
+      return count;
+    }
+
+  } // namespace timer_wheel_detail
+
+  // Hierarchical timer wheel shared by the timers of an io_service.
+  // Obtained by boost::asio::use_service<timer_wheel_service>(io_service)
+  // and used through wheel_timer.
+  // The wheel has four levels of 64 slots at a resolution of 1ms. Arming
+  // and cancelling a timer link and unlink it from a slot, and the timers
+  // of the upper levels are moved down when the lower level wraps around.
+  // One steady_timer wakes the wheel at the next non empty slot of the
+  // lowest level or at the next wrap around, so the asio timer queue holds
+  // a single entry whatever the number of armed timers.
+  // Each pending wait counts as outstanding work of the io_service.
+  // Clock and WaitTraits are those of the steady_timer of the wheel.
+  template <
+      class Clock = std::chrono::steady_clock
+    , class WaitTraits = boost::asio::wait_traits<Clock>
+  >
+  class basic_timer_wheel_service
+    : public boost::asio::io_service::service
+  {
+    static constexpr std::size_t slot_bits = 6;
+    static constexpr std::size_t num_slots = std::size_t{1} << slot_bits;
+    static constexpr std::size_t num_levels = 4;
+    static constexpr std::uint64_t slot_mask = num_slots - 1;
+    static constexpr std::uint64_t never
+      = std::numeric_limits<std::uint64_t>::max();
+
+    using node = timer_wheel_detail::timer_node;
+    using wait_op = timer_wheel_detail::wait_op;
+
+  public:
+    using clock_type = Clock;
+    using duration = typename clock_type::duration;
+    using time_point = typename clock_type::time_point;
+
+    static boost::asio::io_service::id id;
+
+    explicit basic_timer_wheel_service(boost::asio::io_service& io_service)
+      : boost::asio::io_service::service(io_service)
+      , io_service_(io_service)
+      , timer_{io_service}
+      , epoch_(clock_type::now())
+      , current_tick_{0}
+      , armed_tick_{never}
+      , size_{0}
+    {
+      for (auto& level : slots_) {
+        for (auto& head : level) {
+          head.prev = head.next = &head;
+        }
+      }
+      unscheduled_.prev = unscheduled_.next = &unscheduled_;
+    }
+
+    auto get_io_service() noexcept
+      -> boost::asio::io_service&
+    {
+      return io_service_;
+    }
+
+    static auto resolution() noexcept
+      -> duration
+    {
+      return std::chrono::milliseconds{1};
+    }
+
+    // Number of the timers armed in the wheel.
+    auto size() const
+      -> std::size_t
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      return size_;
+    }
+
+    template <class WaitHandler>
+    void async_wait(node& n, time_point const expiry, WaitHandler& handler)
+    {
+      auto const op = timer_wheel_detail::wait_handler_op<WaitHandler>::create(
+          handler, io_service_);
+      std::lock_guard<std::mutex> lock{mutex_};
+      op->next = n.ops;
+      n.ops = op;
+      if (!n.is_linked()) {
+        schedule(n, to_tick(expiry));
+      }
+    }
+
+    auto cancel(node& n)
+      -> std::size_t
+    {
+      auto ops = static_cast<wait_op*>(nullptr);
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (!n.is_linked()) {
+          return 0;
+        }
+        if (n.expiry != never) {
+          --size_;
+        }
+        n.unlink();
+        ops = n.take_ops();
+      }
+      return timer_wheel_detail::complete_all(
+          ops, &io_service_, boost::asio::error::operation_aborted);
+    }
+
+  private:
+    void shutdown_service() override
+    {
+      auto ops = static_cast<wait_op*>(nullptr);
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        auto const take_all = [&](node& head) {
+          while (head.next != &head) {
+            auto& n = *head.next;
+            n.unlink();
+            for (auto op = n.take_ops(); op; ) {
+              auto const next = op->next;
+              op->next = ops;
+              ops = op;
+              op = next;
+            }
+          }
+        };
+        for (auto& level : slots_) {
+          std::for_each(std::begin(level), std::end(level), take_all);
+        }
+        take_all(unscheduled_);
+        size_ = 0;
+      }
+      // the handlers may own timers which are cancelled on destruction
+      timer_wheel_detail::complete_all(ops, nullptr, {});
+    }
+
+    auto to_tick(time_point const t) const noexcept
+      -> std::uint64_t
+    {
+      if (t == time_point::max()) {
+        return never;
+      }
+      if (t <= epoch_) {
+        return 0;
+      }
+      auto const res = resolution().count();
+      return std::uint64_t(((t - epoch_).count() + res - 1) / res);
+    }
+
+    auto now_tick() const noexcept
+      -> std::uint64_t
+    {
+      return std::uint64_t((clock_type::now() - epoch_) / resolution());
+    }
+
+    void schedule(node& n, std::uint64_t const expiry)
+    {
+      n.expiry = expiry;
+      if (expiry == never) {
+        n.link_before(unscheduled_);
+        return;
+      }
+      if (size_++ == 0) {
+        current_tick_ = std::max(current_tick_, now_tick());
+      }
+      place(n, current_tick_ + 1);
+      arm(next_wakeup());
+    }
+
+    // Timers are placed no earlier than first_tick. A timer moved down at
+    // its expiry tick goes to the slot of the current tick, which advance
+    // expires right after moving the timers down.
+    void place(node& n, std::uint64_t const first_tick)
+    {
+      auto expiry = std::max(n.expiry, first_tick);
+      auto const delta = expiry - current_tick_;
+      auto level = std::size_t{0};
+      while (level + 1 < num_levels
+          && delta >= (std::uint64_t{1} << ((level + 1) * slot_bits))) {
+        ++level;
+      }
+      auto const span = std::uint64_t{1} << (num_levels * slot_bits);
+      if (delta >= span) {
+        // placed at the furthest slot and moved down again from there
+        expiry = current_tick_ + span - 1;
+      }
+      auto const index = (expiry >> (level * slot_bits)) & slot_mask;
+      n.link_before(slots_[level][index]);
+    }
+
+    auto next_wakeup() const noexcept
+      -> std::uint64_t
+    {
+      auto tick = current_tick_ + 1;
+      while ((tick & slot_mask) != 0) {
+        auto const& head = slots_[0][tick & slot_mask];
+        if (head.next != &head) {
+          break;
+        }
+        ++tick;
+      }
+      return tick;
+    }
+
+    void arm(std::uint64_t const tick)
+    {
+      if (tick >= armed_tick_) {
+        return;
+      }
+      armed_tick_ = tick;
+      timer_.expires_at(epoch_ + tick * resolution());
+      timer_.async_wait(canard::make_recycling_handler(
+            [this](boost::system::error_code const& ec) {
+              if (ec != boost::asio::error::operation_aborted) {
+                handle_wakeup();
+              }
+      }));
+    }
+
+    void handle_wakeup()
+    {
+      auto expired = static_cast<wait_op*>(nullptr);
+      {
+        std::lock_guard<std::mutex> lock{mutex_};
+        armed_tick_ = never;
+        auto const now = now_tick();
+        while (size_ != 0 && current_tick_ < now) {
+          advance(expired);
+        }
+        if (size_ != 0) {
+          arm(next_wakeup());
+        }
+      }
+      timer_wheel_detail::complete_all(
+          expired, &io_service_, boost::system::error_code{});
+    }
+
+    void advance(wait_op*& expired)
+    {
+      ++current_tick_;
+      auto index = current_tick_ & slot_mask;
+      for (auto level = std::size_t{1};
+          index == 0 && level < num_levels; ++level) {
+        index = (current_tick_ >> (level * slot_bits)) & slot_mask;
+        cascade(slots_[level][index]);
+      }
+      auto& head = slots_[0][current_tick_ & slot_mask];
+      while (head.next != &head) {
+        auto& n = *head.next;
+        n.unlink();
+        --size_;
+        for (auto op = n.take_ops(); op; ) {
+          auto const next = op->next;
+          op->next = expired;
+          expired = op;
+          op = next;
+        }
+      }
+    }
+
+    void cascade(node& head)
+    {
+      auto list = node{};
+      list.prev = list.next = &list;
+      while (head.next != &head) {
+        auto& n = *head.next;
+        n.unlink();
+        n.link_before(list);
+      }
+      while (list.next != &list) {
+        auto& n = *list.next;
+        n.unlink();
+        place(n, current_tick_);
+      }
+    }
+
+  private:
+    boost::asio::io_service& io_service_;
+    mutable std::mutex mutex_;
+    boost::asio::basic_waitable_timer<clock_type, WaitTraits> timer_;
+    time_point const epoch_;
+    std::uint64_t current_tick_;
+    std::uint64_t armed_tick_;
+    std::size_t size_;
+    node slots_[num_levels][num_slots];
+    node unscheduled_;
+  };
+
+  template <class Clock, class WaitTraits>
+  boost::asio::io_service::id
+  basic_timer_wheel_service<Clock, WaitTraits>::id;
+
+  using timer_wheel_service = basic_timer_wheel_service<>;
+
+  // Timer with the interface of boost::asio::steady_timer whose expiry is
+  // kept in the timer_wheel_service of the io_service. A wait completes at
+  // the first tick of the wheel at or after the expiry time.
+  template <
+      class Clock, class WaitTraits = boost::asio::wait_traits<Clock>
+  >
+  class basic_wheel_timer
+  {
+    using service_type = basic_timer_wheel_service<Clock, WaitTraits>;
+
+  public:
+    using clock_type = typename service_type::clock_type;
+    using duration = typename service_type::duration;
+    using time_point = typename service_type::time_point;
+
+    explicit basic_wheel_timer(boost::asio::io_service& io_service)
+      : service_(&boost::asio::use_service<service_type>(io_service))
+      , expiry_(time_point::max())
+    {
+    }
+
+    basic_wheel_timer(basic_wheel_timer const&) = delete;
+    auto operator=(basic_wheel_timer const&) -> basic_wheel_timer& = delete;
+
+    ~basic_wheel_timer()
+    {
+      service_->cancel(node_);
+    }
+
+    auto get_io_service()
+      -> boost::asio::io_service&
+    {
+      return service_->get_io_service();
+    }
+
+    auto expires_at() const noexcept
+      -> time_point
+    {
+      return expiry_;
+    }
+
+    auto expires_at(time_point const expiry_time)
+      -> std::size_t
+    {
+      auto const count = cancel();
+      expiry_ = expiry_time;
+      return count;
+    }
+
+    auto expires_from_now(duration const& expiry_time)
+      -> std::size_t
+    {
+      auto const now = clock_type::now();
+      return expires_at(expiry_time >= time_point::max() - now
+          ? time_point::max() : now + expiry_time);
+    }
+
+    auto cancel()
+      -> std::size_t
+    {
+      return service_->cancel(node_);
+    }
+
+    template <class WaitHandler>
+    auto async_wait(WaitHandler&& handler)
+      -> typename canard::async_result_init<
+            typename std::decay<WaitHandler>::type
+          , void(boost::system::error_code)
+         >::result_type
+    {
+      canard::async_result_init<
+          typename std::decay<WaitHandler>::type
+        , void(boost::system::error_code)
+      > init{std::forward<WaitHandler>(handler)};
+      service_->async_wait(node_, expiry_, init.handler());
+      return init.get();
+    }
+
+  private:
+    service_type* service_;
+    time_point expiry_;
+    timer_wheel_detail::timer_node node_;
+  };
+
+  using wheel_timer = basic_wheel_timer<std::chrono::steady_clock>;
+
+} // namespace utils
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_UTILS_TIMER_WHEEL_HPP
@@ -0,0 +1,123 @@
+#ifndef CANARD_NETWORK_UTILS_WORK_STEALING_HPP
+#define CANARD_NETWORK_UTILS_WORK_STEALING_HPP
+
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <canard/net/utils/io_service_pool.hpp>
+
+namespace canard {
+namespace net {
+namespace utils {
+
+  namespace work_stealing_detail {
+
+    struct idle_state
+    {
+      std::atomic<std::size_t> num_idle_threads{0};
+      std::atomic<bool> is_waking{false};
+    };
+
+  } // namespace work_stealing_detail
+
+  // Thread function for io_service_pool::start.
+  // Each thread runs the handlers of its own io_service, and when that
+  // io_service has no ready handler, it runs a ready handler of the other
+  // io_services in the pool instead.
+  // A thread with nothing to steal blocks on its own io_service. A thread
+  // running a second handler in a row on its io_service without blocking
+  // wakes one of the blocked threads of the other io_services, which then
+  // steals the handlers left ready.
+  // Handlers dispatched through a strand keep their ordering because the
+  // strand, not the thread, serializes them.
+  class work_stealing_runner
+  {
+  public:
+    explicit work_stealing_runner(io_service_pool& pool)
+      : pool_(pool)
+      , idle_states_{
+          std::make_shared<std::vector<work_stealing_detail::idle_state>>(
+              pool.io_service_count())
+        }
+    {
+      if (!pool.is_work_stealing() && pool.io_service_count() > 1) {
+        throw std::invalid_argument{
+          "io_service_pool is not constructed for work stealing"
+        };
+      }
+    }
+
+    void operator()(
+        boost::asio::io_service& io_service, std::size_t const id, std::size_t)
+    {
+      auto& idle = (*idle_states_)[id];
+      auto has_run_ready_handler = false;
+      while (true) {
+        if (io_service.poll_one() != 0) {
+          if (has_run_ready_handler) {
+            wake_idle_thread(id);
+          }
+          has_run_ready_handler = true;
+          continue;
+        }
+        has_run_ready_handler = false;
+        if (io_service.stopped()) {
+          break;
+        }
+        if (steal_one(id)) {
+          continue;
+        }
+        idle.num_idle_threads.fetch_add(1, std::memory_order_acq_rel);
+        auto const count = io_service.run_one();
+        idle.num_idle_threads.fetch_sub(1, std::memory_order_acq_rel);
+        idle.is_waking.store(false, std::memory_order_release);
+        if (count == 0) {
+          break;
+        }
+        has_run_ready_handler = true;
+      }
+    }
+
+  private:
+    auto steal_one(std::size_t const id)
+      -> bool
+    {
+      auto const count = pool_.io_service_count();
+      for (auto i = std::size_t{1}; i < count; ++i) {
+        if (pool_.get_io_service((id + i) % count).poll_one() != 0) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Posts an empty handler to wake a blocked thread, unless one of the
+    // threads of that io_service is already being woken.
+    void wake_idle_thread(std::size_t const id)
+    {
+      auto const count = pool_.io_service_count();
+      for (auto i = std::size_t{1}; i < count; ++i) {
+        auto const other = (id + i) % count;
+        auto& idle = (*idle_states_)[other];
+        if (idle.num_idle_threads.load(std::memory_order_acquire) != 0
+            && !idle.is_waking.exchange(true, std::memory_order_acq_rel)) {
+          pool_.get_io_service(other).post([]{});
+          return;
+        }
+      }
+    }
+
+  private:
+    io_service_pool& pool_;
+    std::shared_ptr<std::vector<work_stealing_detail::idle_state>>
+      idle_states_;
+  };
+
+} // namespace utils
+} // namespace net
+} // namespace canard
+
+#endif // CANARD_NETWORK_UTILS_WORK_STEALING_HPP
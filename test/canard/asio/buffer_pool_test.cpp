@@ -0,0 +1,88 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/asio/buffer_pool.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <thread>
+
+BOOST_AUTO_TEST_SUITE(buffer_pool_test)
+
+BOOST_AUTO_TEST_CASE(reuses_freed_block)
+{
+    auto const before = canard::buffer_pool::statistics();
+
+    auto const p1 = canard::buffer_pool::allocate(100);
+    canard::buffer_pool::deallocate(p1, 100);
+    auto const p2 = canard::buffer_pool::allocate(120);
+    canard::buffer_pool::deallocate(p2, 120);
+
+    auto const after = canard::buffer_pool::statistics();
+    BOOST_TEST(p1 == p2);
+    BOOST_TEST(after.hits - before.hits == 1);
+}
+
+BOOST_AUTO_TEST_CASE(does_not_share_block_between_size_classes)
+{
+    auto const p1 = canard::buffer_pool::allocate(64);
+    canard::buffer_pool::deallocate(p1, 64);
+
+    auto const p2 = canard::buffer_pool::allocate(65);
+    canard::buffer_pool::deallocate(p2, 65);
+
+    BOOST_TEST(p1 != p2);
+}
+
+BOOST_AUTO_TEST_CASE(allocates_oversized_block)
+{
+    auto const before = canard::buffer_pool::statistics();
+    auto const size = std::size_t{128 * 1024};
+
+    auto const p = canard::buffer_pool::allocate(size);
+    std::memset(p, 0xff, size);
+    canard::buffer_pool::deallocate(p, size);
+
+    auto const after = canard::buffer_pool::statistics();
+    BOOST_TEST(after.misses - before.misses == 1);
+}
+
+BOOST_AUTO_TEST_CASE(returns_block_freed_by_other_thread)
+{
+    auto const p1 = canard::buffer_pool::allocate(200);
+    auto const before = canard::buffer_pool::statistics();
+
+    std::thread{[p1]{ canard::buffer_pool::deallocate(p1, 200); }}.join();
+    auto const p2 = canard::buffer_pool::allocate(200);
+    canard::buffer_pool::deallocate(p2, 200);
+
+    auto const after = canard::buffer_pool::statistics();
+    BOOST_TEST(p1 == p2);
+    BOOST_TEST(after.remote_deallocations - before.remote_deallocations == 1);
+}
+
+BOOST_AUTO_TEST_CASE(frees_block_of_exited_thread)
+{
+    void* p = nullptr;
+    std::thread{[&p]{ p = canard::buffer_pool::allocate(300); }}.join();
+
+    canard::buffer_pool::deallocate(p, 300);
+}
+
+BOOST_AUTO_TEST_CASE(pooled_shared_buffer)
+{
+    auto const before = canard::buffer_pool::statistics();
+
+    {
+        auto const buffer = canard::pooled_shared_buffer(1000);
+        std::memset(buffer.data(), 0x01, buffer.size());
+        BOOST_TEST(buffer.size() == 1000);
+    }
+    {
+        auto const buffer = canard::pooled_shared_buffer(900);
+        BOOST_TEST(buffer.size() == 900);
+    }
+
+    auto const after = canard::buffer_pool::statistics();
+    BOOST_TEST(after.hits - before.hits == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // buffer_pool_test
@@ -0,0 +1,116 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/asio/receive_buffer.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <boost/asio/buffer.hpp>
+
+namespace {
+
+    void fill(canard::receive_buffer& sut, std::size_t const size
+            , unsigned char const value)
+    {
+        auto const buffer = sut.prepare(size);
+        std::memset(boost::asio::buffer_cast<unsigned char*>(buffer), value, size);
+        sut.commit(size);
+    }
+
+}
+
+BOOST_AUTO_TEST_SUITE(receive_buffer_test)
+
+BOOST_AUTO_TEST_CASE(construct)
+{
+    auto const sut = canard::receive_buffer{64};
+
+    BOOST_TEST(sut.size() == 0);
+    BOOST_TEST(sut.capacity() == 64);
+}
+
+BOOST_AUTO_TEST_CASE(construct_with_zero_capacity)
+{
+    auto sut = canard::receive_buffer{0};
+
+    BOOST_TEST(sut.size() == 0);
+    BOOST_TEST(sut.capacity() == 0);
+    BOOST_TEST(boost::asio::buffer_size(sut.prepare(8)) == 8);
+}
+
+BOOST_AUTO_TEST_CASE(prepare_returns_whole_free_space)
+{
+    auto sut = canard::receive_buffer{64};
+
+    auto const buffer = sut.prepare(8);
+
+    BOOST_TEST(boost::asio::buffer_size(buffer) == 64);
+}
+
+BOOST_AUTO_TEST_CASE(commit_and_consume)
+{
+    auto sut = canard::receive_buffer{64};
+    fill(sut, 16, 0x01);
+    auto const first = sut.data();
+
+    sut.consume(8);
+
+    BOOST_TEST(sut.size() == 8);
+    BOOST_TEST(sut.data() == first + 8);
+}
+
+BOOST_AUTO_TEST_CASE(consume_all_rewinds)
+{
+    auto sut = canard::receive_buffer{64};
+    fill(sut, 16, 0x01);
+    auto const first = sut.data();
+
+    sut.consume(16);
+
+    BOOST_TEST(sut.size() == 0);
+    BOOST_TEST(sut.data() == first);
+    BOOST_TEST(boost::asio::buffer_size(sut.prepare(1)) == 64);
+}
+
+BOOST_AUTO_TEST_CASE(does_not_compact_if_tail_is_enough)
+{
+    auto sut = canard::receive_buffer{64};
+    fill(sut, 32, 0x01);
+    sut.consume(24);
+    auto const data = sut.data();
+
+    sut.prepare(32);
+
+    BOOST_TEST(sut.data() == data);
+}
+
+BOOST_AUTO_TEST_CASE(compacts_partial_message)
+{
+    auto sut = canard::receive_buffer{64};
+    fill(sut, 56, 0x01);
+    fill(sut, 8, 0x02);
+    sut.consume(56);
+
+    auto const buffer = sut.prepare(16);
+
+    BOOST_TEST(sut.capacity() == 64);
+    BOOST_TEST(sut.size() == 8);
+    BOOST_TEST(boost::asio::buffer_size(buffer) == 56);
+    BOOST_TEST(sut.data()[0] == 0x02);
+    BOOST_TEST(sut.data()[7] == 0x02);
+}
+
+BOOST_AUTO_TEST_CASE(grows_for_large_message)
+{
+    auto sut = canard::receive_buffer{64};
+    fill(sut, 48, 0x01);
+    fill(sut, 8, 0x02);
+    sut.consume(48);
+
+    sut.prepare(120);
+
+    BOOST_TEST(sut.capacity() == 128);
+    BOOST_TEST(sut.size() == 8);
+    BOOST_TEST(sut.data()[0] == 0x02);
+    BOOST_TEST(sut.data()[7] == 0x02);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // receive_buffer_test
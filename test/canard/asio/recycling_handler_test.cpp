@@ -0,0 +1,67 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/asio/recycling_handler.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <boost/asio/io_service.hpp>
+
+namespace {
+
+    struct counting_invoke_handler
+    {
+        void operator()() const
+        {
+            ++*count;
+        }
+
+        template <class Function>
+        friend void asio_handler_invoke(
+                Function& function, counting_invoke_handler* const h)
+        {
+            ++*h->num_invocations;
+            function();
+        }
+
+        int* num_invocations;
+        int* count;
+    };
+
+}
+
+BOOST_AUTO_TEST_SUITE(recycling_handler_test)
+
+BOOST_AUTO_TEST_CASE(reuses_storage_of_completed_handler)
+{
+    boost::asio::io_service io_service{};
+    auto payload = std::array<char, 100>{};
+    auto count = 0;
+
+    io_service.post(canard::make_recycling_handler([&, payload]{ ++count; }));
+    io_service.run();
+    io_service.reset();
+
+    auto const before = canard::buffer_pool::statistics();
+    io_service.post(canard::make_recycling_handler([&, payload]{ ++count; }));
+    io_service.run();
+
+    auto const after = canard::buffer_pool::statistics();
+    BOOST_TEST(count == 2);
+    BOOST_TEST(after.hits - before.hits == 1);
+    BOOST_TEST(after.misses == before.misses);
+}
+
+BOOST_AUTO_TEST_CASE(propagates_invocation_to_wrapped_handler)
+{
+    boost::asio::io_service io_service{};
+    auto num_invocations = 0;
+    auto count = 0;
+
+    io_service.post(canard::make_recycling_handler(
+                counting_invoke_handler{&num_invocations, &count}));
+    io_service.run();
+
+    BOOST_TEST(count == 1);
+    BOOST_TEST(num_invocations == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // recycling_handler_test
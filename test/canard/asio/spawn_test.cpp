@@ -0,0 +1,55 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/asio/spawn.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/system/error_code.hpp>
+
+BOOST_AUTO_TEST_SUITE(spawn_test)
+
+BOOST_AUTO_TEST_CASE(resumes_coroutine_on_completion)
+{
+    boost::asio::io_service io_service{};
+    boost::asio::io_service::strand strand{io_service};
+    auto started_in_strand = false;
+    auto ec = boost::system::error_code{boost::asio::error::operation_aborted};
+
+    canard::spawn(strand, [&](canard::yield_context yield) {
+        started_in_strand = strand.running_in_this_thread();
+        boost::asio::steady_timer timer{io_service};
+        timer.expires_from_now(std::chrono::milliseconds{1});
+        timer.async_wait(yield[ec]);
+    });
+    io_service.run();
+
+    BOOST_TEST(started_in_strand);
+    BOOST_TEST(!ec);
+}
+
+BOOST_AUTO_TEST_CASE(reuses_stack_of_completed_coroutine)
+{
+    boost::asio::io_service io_service{};
+    boost::asio::io_service::strand strand{io_service};
+    void const* first = nullptr;
+    void const* second = nullptr;
+
+    canard::spawn(strand, [&](canard::yield_context) {
+        auto const local = 0;
+        first = &local;
+    });
+    io_service.run();
+    io_service.reset();
+    canard::spawn(strand, [&](canard::yield_context) {
+        auto const local = 0;
+        second = &local;
+    });
+    io_service.run();
+
+    BOOST_TEST(first == second);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // spawn_test
@@ -0,0 +1,240 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/net/ofp/controller/dispatch_table.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+#include <canard/net/ofp/controller/v13/openflow_channel.hpp>
+
+namespace controller = canard::net::ofp::controller;
+namespace v13 = canard::net::ofp::v13;
+
+namespace {
+
+  template <std::size_t Key>
+  struct message
+  {
+    static constexpr std::size_t key = Key;
+  };
+
+  struct channel {};
+
+  // Records the messages passed to the entries of the table.
+  struct reader
+  {
+    std::vector<std::type_index> handled;
+    std::size_t num_unknown;
+  };
+
+  template <class Base>
+  struct recording_traits
+    : Base
+  {
+    using header_type = typename Base::header_type;
+
+    template <class Message, class Reader, class Channel>
+    static void handle(
+          Reader* const r, Channel const&, header_type const&
+        , unsigned char const*, unsigned char const*)
+    {
+      r->handled.push_back(typeid(Message));
+    }
+
+    template <class Reader, class Channel>
+    static void handle_unknown(
+          Reader* const r, Channel const&, header_type const&
+        , unsigned char const*, unsigned char const*)
+    {
+      ++r->num_unknown;
+    }
+  };
+
+  // Counts the messages decoded by the version's handle_message.
+  struct counting_reader
+  {
+    template <class Channel, class Message>
+    void handle(Channel const&, Message&&)
+    {
+      ++num_messages;
+    }
+
+    void handle_decode_error()
+    {
+      ++num_decode_errors;
+    }
+
+    std::size_t num_messages;
+    std::size_t num_decode_errors;
+  };
+
+  struct message_key
+  {
+    using header_type = std::uint8_t;
+
+    template <class Message>
+    static constexpr auto key() noexcept
+      -> std::size_t
+    {
+      return Message::key;
+    }
+  };
+
+  using traits = recording_traits<message_key>;
+  using known_list = std::tuple<message<0>, message<2>, message<5>>;
+  using handled_list = std::tuple<message<0>, message<5>>;
+  using sut = controller::dispatch_table<traits, known_list, handled_list>;
+
+  template <class HandledMessage, class KnownMessage>
+  using entry = controller::dispatch_table_detail::entry<
+    traits, reader, channel, HandledMessage, KnownMessage
+  >;
+
+  static_assert(
+        entry<message<0>, message<0>>::value
+        == &traits::handle<message<0>, reader, channel>
+      , "handled message is passed to handle");
+  static_assert(
+        entry<void, message<2>>::value
+        == &controller::dispatch_table_detail::ignore<traits, reader, channel>
+      , "known message not handled is ignored");
+  static_assert(
+        entry<void, void>::value
+        == &traits::handle_unknown<reader, channel>
+      , "unknown message is passed to handle_unknown");
+
+  template <class Table, class Traits, class MessageList>
+  struct dispatch_all;
+
+  template <class Table, class Traits, class... Messages>
+  struct dispatch_all<Table, Traits, std::tuple<Messages...>>
+  {
+    // Dispatches each message of the list by its key and returns the types
+    // of the messages passed to handle.
+    auto operator()() const
+      -> std::vector<std::type_index>
+    {
+      auto r = reader{{}, 0};
+      auto const header = typename Traits::header_type{};
+      auto const keys = std::vector<std::size_t>{
+        Traits::template key<Messages>()...
+      };
+      for (auto const key : keys) {
+        Table::dispatch(key, &r, channel{}, header, nullptr, nullptr);
+      }
+      BOOST_TEST(r.num_unknown == 0);
+      return r.handled;
+    }
+  };
+
+  template <class... Messages>
+  auto types_of(std::tuple<Messages...> const*)
+    -> std::vector<std::type_index>
+  {
+    return std::vector<std::type_index>{typeid(Messages)...};
+  }
+
+  template <class Traits, class MessageList>
+  void check_all_reachable()
+  {
+    using table = controller::dispatch_table<Traits, MessageList>;
+    auto const handled = dispatch_all<table, Traits, MessageList>{}();
+    auto const expected = types_of(static_cast<MessageList const*>(nullptr));
+    BOOST_TEST((handled == expected));
+  }
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(dispatch_table_test)
+
+BOOST_AUTO_TEST_CASE(passes_handled_message_to_handle)
+{
+    auto r = reader{{}, 0};
+
+    sut::dispatch(5, &r, channel{}, 0, nullptr, nullptr);
+    sut::dispatch(0, &r, channel{}, 0, nullptr, nullptr);
+
+    BOOST_TEST_REQUIRE(r.handled.size() == 2);
+    BOOST_TEST((r.handled[0] == typeid(message<5>)));
+    BOOST_TEST((r.handled[1] == typeid(message<0>)));
+    BOOST_TEST(r.num_unknown == 0);
+}
+
+BOOST_AUTO_TEST_CASE(ignores_known_message_not_handled)
+{
+    auto r = reader{{}, 0};
+
+    sut::dispatch(2, &r, channel{}, 0, nullptr, nullptr);
+
+    BOOST_TEST(r.handled.empty());
+    BOOST_TEST(r.num_unknown == 0);
+}
+
+BOOST_AUTO_TEST_CASE(passes_unknown_type_to_handle_unknown)
+{
+    auto r = reader{{}, 0};
+
+    sut::dispatch(1, &r, channel{}, 0, nullptr, nullptr);
+    sut::dispatch(4, &r, channel{}, 0, nullptr, nullptr);
+
+    BOOST_TEST(r.handled.empty());
+    BOOST_TEST(r.num_unknown == 2);
+}
+
+BOOST_AUTO_TEST_CASE(passes_out_of_range_type_to_handle_unknown)
+{
+    auto r = reader{{}, 0};
+
+    sut::dispatch(6, &r, channel{}, 0, nullptr, nullptr);
+    sut::dispatch(255, &r, channel{}, 0, nullptr, nullptr);
+
+    BOOST_TEST(r.handled.empty());
+    BOOST_TEST(r.num_unknown == 2);
+}
+
+BOOST_AUTO_TEST_CASE(reaches_all_v13_messages)
+{
+    namespace detail = controller::v13::handle_message_detail;
+
+    check_all_reachable<
+        recording_traits<detail::message_traits>
+      , detail::switch_message_list
+    >();
+}
+
+BOOST_AUTO_TEST_CASE(reaches_all_v13_multipart_replies)
+{
+    namespace detail = controller::v13::handle_message_detail;
+
+    check_all_reachable<
+        recording_traits<detail::multipart_reply_traits>
+      , detail::multipart_reply_list
+    >();
+}
+
+BOOST_AUTO_TEST_CASE(v13_unknown_type_is_decode_error_after_known_type)
+{
+    using handle_message = controller::v13::basic_handle_message<
+      std::tuple<v13::messages::barrier_reply>
+    >;
+    auto r = counting_reader{0, 0};
+    auto bytes = std::vector<unsigned char>{};
+    v13::messages::barrier_reply{}.encode(bytes);
+    auto header = handle_message::header_type{};
+    header.length = bytes.size();
+
+    header.type = v13::protocol::OFPT_BARRIER_REPLY;
+    handle_message{}(
+        &r, channel{}, header, bytes.data(), bytes.data() + bytes.size());
+    header.type = 200;
+    handle_message{}(
+        &r, channel{}, header, bytes.data(), bytes.data() + bytes.size());
+
+    BOOST_TEST(r.num_messages == 1);
+    BOOST_TEST(r.num_decode_errors == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // dispatch_table_test
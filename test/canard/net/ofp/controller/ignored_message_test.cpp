@@ -0,0 +1,164 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/net/ofp/controller/ignored_message.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <canard/net/ofp/controller/dispatch_table.hpp>
+
+namespace controller = canard::net::ofp::controller;
+
+namespace {
+
+  template <std::size_t Key>
+  struct message
+  {
+    static constexpr std::size_t key = Key;
+  };
+
+  using known_list = std::tuple<message<0>, message<1>, message<2>>;
+
+  struct channel {};
+
+  template <class T>
+  using as_is = T;
+
+  template <class Handler>
+  using handled_list = controller::detail::handled_message_list_t<
+    Handler, channel, known_list, as_is
+  >;
+
+  struct handle_all
+  {
+    template <class Message>
+    void handle(channel const&, Message const&)
+    {
+    }
+  };
+
+  struct ignore_all_but_one
+  {
+    void handle(channel const&, message<1> const&)
+    {
+    }
+
+    template <class... Args>
+    auto handle(Args const&...)
+      -> controller::ignored_message
+    {
+      return {};
+    }
+  };
+
+  struct ignore_all
+  {
+    template <class... Args>
+    auto handle(Args const&...)
+      -> controller::ignored_message
+    {
+      return {};
+    }
+  };
+
+  template <class Base>
+  struct intercept_zero
+    : Base
+  {
+    using intercepted_message_list = std::tuple<message<0>>;
+  };
+
+  // message<3> is not known, so it is never dispatched.
+  template <class Base>
+  struct intercept_two
+    : Base
+  {
+    using intercepted_message_list = std::tuple<message<2>, message<3>>;
+  };
+
+  struct decorated_handler
+    : controller::decorate<decorated_handler, intercept_zero, intercept_two>
+  {
+    template <class... Args>
+    auto handle(Args const&...)
+      -> controller::ignored_message
+    {
+      return {};
+    }
+  };
+
+  // Counts the messages decoded by the table.
+  struct reader
+  {
+    std::size_t num_decoded;
+  };
+
+  struct traits
+  {
+    using header_type = std::uint8_t;
+
+    template <class Message>
+    static constexpr auto key() noexcept
+      -> std::size_t
+    {
+      return Message::key;
+    }
+
+    template <class Message, class Reader, class Channel>
+    static void handle(
+          Reader* const r, Channel const&, header_type const&
+        , unsigned char const*, unsigned char const*)
+    {
+      ++r->num_decoded;
+    }
+
+    template <class Reader, class Channel>
+    static void handle_unknown(
+          Reader*, Channel const&, header_type const&
+        , unsigned char const*, unsigned char const*)
+    {
+    }
+  };
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(ignored_message_test)
+
+BOOST_AUTO_TEST_CASE(catch_all_handler_receives_all_messages)
+{
+    BOOST_TEST((std::is_same<handled_list<handle_all>, known_list>::value));
+}
+
+BOOST_AUTO_TEST_CASE(ignored_message_catch_all_filters_other_messages)
+{
+    BOOST_TEST((std::is_same<
+          handled_list<ignore_all_but_one>, std::tuple<message<1>>
+    >::value));
+    BOOST_TEST((std::is_same<handled_list<ignore_all>, std::tuple<>>::value));
+}
+
+BOOST_AUTO_TEST_CASE(merges_intercepted_message_lists_of_decorators)
+{
+    BOOST_TEST((std::is_same<
+          handled_list<decorated_handler>, std::tuple<message<0>, message<2>>
+    >::value));
+}
+
+BOOST_AUTO_TEST_CASE(drops_filtered_message_without_decoding)
+{
+    using table = controller::dispatch_table<
+      traits, known_list, handled_list<ignore_all_but_one>
+    >;
+    auto r = reader{0};
+
+    table::dispatch(0, &r, channel{}, 0, nullptr, nullptr);
+    table::dispatch(2, &r, channel{}, 0, nullptr, nullptr);
+    auto const num_decoded_filtered = r.num_decoded;
+    table::dispatch(1, &r, channel{}, 0, nullptr, nullptr);
+
+    BOOST_TEST(num_decoded_filtered == 0);
+    BOOST_TEST(r.num_decoded == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // ignored_message_test
@@ -0,0 +1,181 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/net/ofp/controller/message_batch.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include <canard/net/ofp/hello.hpp>
+
+namespace controller = canard::net::ofp::controller;
+namespace ofp = canard::net::ofp;
+
+namespace {
+
+  struct channel {};
+
+  struct reply
+  {
+    std::uint32_t xid;
+  };
+
+  // Dispatches the xid of a message of type 0, a reply for type 1 and
+  // rejects any other type.
+  struct message_handler
+  {
+    using header_type = ofp::ofp_header;
+
+    template <class Reader>
+    void operator()(
+          Reader* const reader, channel const& c
+        , header_type const& header
+        , unsigned char const*, unsigned char const*) const
+    {
+      switch (header.type) {
+      case 0:
+        controller::detail::reader_access::handle(
+            reader, c, std::uint32_t{header.xid});
+        break;
+      case 1:
+        controller::detail::reader_access::handle(
+            reader, c, reply{header.xid});
+        break;
+      default:
+        controller::detail::reader_access::handle_decode_error(reader);
+        break;
+      }
+    }
+  };
+
+  // Records the replies dispatched one by one.
+  struct reader
+  {
+    void handle(channel const&, reply const& r)
+    {
+      reply_xids.push_back(r.xid);
+    }
+
+    void handle_decode_error()
+    {
+      ++num_decode_errors;
+    }
+
+    std::vector<std::uint32_t> reply_xids;
+    std::size_t num_decode_errors;
+  };
+
+  void put_header(
+      std::vector<unsigned char>& bytes
+    , std::uint8_t const type, std::uint32_t const xid)
+  {
+    auto const header = std::vector<unsigned char>{
+        4, type, 0, 8
+      , std::uint8_t(xid >> 24), std::uint8_t(xid >> 16)
+      , std::uint8_t(xid >> 8), std::uint8_t(xid)
+    };
+    bytes.insert(bytes.end(), header.begin(), header.end());
+  }
+
+  using batch = controller::message_batch<message_handler, reader, channel>;
+  using intercepting_batch = controller::message_batch<
+      message_handler, reader, channel
+    , controller::eager_decode, std::tuple<reply>
+  >;
+
+  // Records the xids of the visited messages.
+  struct visitor
+  {
+    void operator()(std::uint32_t const xid)
+    {
+      xids.push_back(xid);
+    }
+
+    void operator()(reply const& r)
+    {
+      xids.push_back(r.xid);
+    }
+
+    std::vector<std::uint32_t>& xids;
+  };
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(message_batch_test)
+
+BOOST_AUTO_TEST_CASE(visits_messages_in_order)
+{
+    auto bytes = std::vector<unsigned char>{};
+    put_header(bytes, 0, 1);
+    put_header(bytes, 0, 2);
+    auto r = reader{{}, 0};
+    auto const c = channel{};
+    auto const sut = batch{
+      bytes.data(), bytes.data() + bytes.size(), 2, &r, c
+    };
+    auto xids = std::vector<std::uint32_t>{};
+
+    sut.for_each(visitor{xids});
+
+    BOOST_TEST(xids == (std::vector<std::uint32_t>{1, 2}));
+    BOOST_TEST(r.num_decode_errors == 0);
+}
+
+BOOST_AUTO_TEST_CASE(forwards_decode_error_to_reader)
+{
+    auto bytes = std::vector<unsigned char>{};
+    put_header(bytes, 0, 1);
+    put_header(bytes, 2, 2);
+    put_header(bytes, 0, 3);
+    auto r = reader{{}, 0};
+    auto const c = channel{};
+    auto const sut = batch{
+      bytes.data(), bytes.data() + bytes.size(), 3, &r, c
+    };
+    auto xids = std::vector<std::uint32_t>{};
+
+    sut.for_each(visitor{xids});
+
+    BOOST_TEST(xids == (std::vector<std::uint32_t>{1, 3}));
+    BOOST_TEST(r.num_decode_errors == 1);
+}
+
+BOOST_AUTO_TEST_CASE(visits_messages_not_intercepted)
+{
+    auto bytes = std::vector<unsigned char>{};
+    put_header(bytes, 0, 1);
+    put_header(bytes, 1, 2);
+    auto r = reader{{}, 0};
+    auto const c = channel{};
+    auto const sut = batch{
+      bytes.data(), bytes.data() + bytes.size(), 2, &r, c
+    };
+    auto xids = std::vector<std::uint32_t>{};
+
+    sut.for_each(visitor{xids});
+
+    BOOST_TEST(xids == (std::vector<std::uint32_t>{1, 2}));
+    BOOST_TEST(r.reply_xids.empty());
+}
+
+BOOST_AUTO_TEST_CASE(passes_intercepted_messages_to_reader)
+{
+    auto bytes = std::vector<unsigned char>{};
+    put_header(bytes, 0, 1);
+    put_header(bytes, 1, 2);
+    put_header(bytes, 0, 3);
+    put_header(bytes, 1, 4);
+    auto r = reader{{}, 0};
+    auto const c = channel{};
+    auto const sut = intercepting_batch{
+      bytes.data(), bytes.data() + bytes.size(), 4, &r, c
+    };
+    auto xids = std::vector<std::uint32_t>{};
+
+    sut.for_each(visitor{xids});
+
+    BOOST_TEST(xids == (std::vector<std::uint32_t>{1, 3}));
+    BOOST_TEST(r.reply_xids == (std::vector<std::uint32_t>{2, 4}));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // message_batch_test
@@ -0,0 +1,60 @@
+#define BOOST_TEST_DYN_LINK
+#define CANARD_NET_OFP_CONTROLLER_DISABLE_PROFILING
+#include <canard/net/ofp/controller/profiling_decorator.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace controller = canard::net::ofp::controller;
+
+namespace {
+
+  struct message
+  {
+    auto type() const noexcept
+      -> std::uint8_t
+    {
+      return 10;
+    }
+  };
+
+  // Not shared with profiling_decorator_test.cpp, which profiles
+  // the decorator built without the macro.
+  struct disabled_base
+  {
+    template <class Channel, class Message>
+    void forward(Channel const&, Message&&)
+    {
+      ++num_forwarded;
+    }
+
+    std::size_t num_forwarded = 0;
+  };
+
+  struct channel {};
+
+  using decorator = controller::profiling_decorator<disabled_base>;
+
+  static_assert(
+        sizeof(decorator) == sizeof(disabled_base)
+      , "profiling_decorator must have no state when profiling is disabled");
+
+}
+
+BOOST_AUTO_TEST_SUITE(profiling_decorator_disabled_test)
+
+BOOST_AUTO_TEST_CASE(forwards_without_recording)
+{
+    decorator sut;
+
+    sut.handle(channel{}, message{});
+
+    auto const profile = sut.profile();
+    BOOST_TEST(sut.num_forwarded == 1);
+    for (auto i = std::size_t{0}; i < profile.handler_time.size(); ++i) {
+      BOOST_TEST(profile.handler_time[i].count() == 0);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END() // profiling_decorator_disabled_test
@@ -0,0 +1,87 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/net/ofp/controller/profiling_decorator.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+
+namespace controller = canard::net::ofp::controller;
+
+namespace {
+
+  struct message
+  {
+    auto type() const noexcept
+      -> std::uint8_t
+    {
+      return type_;
+    }
+
+    std::uint8_t type_;
+  };
+
+  struct message_without_type {};
+
+  struct counting_base
+  {
+    template <class Channel, class Message>
+    void forward(Channel const&, Message&&)
+    {
+      ++num_forwarded;
+      std::this_thread::sleep_for(delay);
+    }
+
+    std::size_t num_forwarded = 0;
+    std::chrono::microseconds delay{0};
+  };
+
+  struct channel {};
+
+  using decorator = controller::profiling_decorator<counting_base>;
+
+}
+
+BOOST_AUTO_TEST_SUITE(profiling_decorator_test)
+
+BOOST_AUTO_TEST_CASE(records_handler_time_per_message_type)
+{
+    decorator sut;
+    sut.delay = std::chrono::microseconds{1000};
+
+    sut.handle(channel{}, message{10});
+    sut.handle(channel{}, message{10});
+    sut.handle(channel{}, message{14});
+
+    auto const profile = sut.profile();
+    BOOST_TEST(sut.num_forwarded == 3);
+    BOOST_TEST(profile.handler_time[10].count() == 2);
+    BOOST_TEST(profile.handler_time[14].count() == 1);
+    BOOST_TEST(profile.handler_time[10].sum() >= 2000000);
+    BOOST_TEST(profile.handler_time[0].count() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(records_untyped_and_large_types_in_last)
+{
+    decorator sut;
+    auto const last = controller::handler_profile::max_message_types - 1;
+
+    sut.handle(channel{}, message_without_type{});
+    sut.handle(channel{}, message{200});
+
+    auto const profile = sut.profile();
+    BOOST_TEST(profile.handler_time[last].count() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(merges_records_of_all_threads)
+{
+    decorator sut;
+
+    sut.handle(channel{}, message{1});
+    std::thread{[&]{ sut.handle(channel{}, message{1}); }}.join();
+
+    BOOST_TEST(sut.profile().handler_time[1].count() == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // profiling_decorator_test
@@ -0,0 +1,274 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/net/ofp/controller/secure_channel.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/system/error_code.hpp>
+#include <canard/net/ofp/v13/messages.hpp>
+
+namespace controller = canard::net::ofp::controller;
+namespace v13 = canard::net::ofp::v13;
+using tcp = boost::asio::ip::tcp;
+
+namespace {
+
+  struct connected_channel
+  {
+    explicit connected_channel(
+          controller::write_coalescing_options const& options
+        , controller::write_backpressure_options const& backpressure_options
+            = controller::write_backpressure_options{})
+      : strand{io_service}
+      , client{io_service}
+    {
+      auto acceptor = tcp::acceptor{
+        io_service, tcp::endpoint{boost::asio::ip::address_v4::loopback(), 0}
+      };
+      client.connect(acceptor.local_endpoint());
+      auto server = tcp::socket{io_service};
+      acceptor.accept(server);
+      channel = std::make_shared<controller::secure_channel<tcp::socket>>(
+          std::move(server), strand, options, backpressure_options);
+    }
+
+    auto dropped_messages()
+      -> std::uint64_t
+    {
+      return boost::asio::use_service<controller::channel_metrics_registry>(
+          io_service).collect().total.dropped_messages;
+    }
+
+    auto received_bytes()
+      -> std::size_t
+    {
+      auto buffer = std::vector<unsigned char>(1024);
+      auto ec = boost::system::error_code{};
+      client.non_blocking(true);
+      return client.read_some(boost::asio::buffer(buffer), ec);
+    }
+
+    boost::asio::io_service io_service;
+    boost::asio::io_service::strand strand;
+    tcp::socket client;
+    std::shared_ptr<controller::secure_channel<tcp::socket>> channel;
+  };
+
+  auto flush_at_handler_exit()
+    -> controller::write_coalescing_options
+  {
+    return controller::write_coalescing_options{}.flush_at_handler_exit(true);
+  }
+
+  // Unwritable while two barrier_requests are queued.
+  auto water_marks()
+    -> controller::write_backpressure_options
+  {
+    return controller::write_backpressure_options{}
+      .high_water_mark(2 * v13::messages::barrier_request{}.length())
+      .low_water_mark(0);
+  }
+
+  struct write_result
+  {
+    void operator()(boost::system::error_code const& ec, std::size_t bytes)
+    {
+      *error = ec;
+      *written = bytes;
+    }
+
+    std::shared_ptr<boost::system::error_code> error;
+    std::shared_ptr<std::size_t> written;
+  };
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(secure_channel_test)
+
+BOOST_AUTO_TEST_CASE(writes_message_sent_from_posted_handler)
+{
+    connected_channel sut{flush_at_handler_exit()};
+    auto const channel = sut.channel;
+
+    sut.strand.post([channel]{
+        channel->async_send(v13::messages::barrier_request{});
+    });
+    sut.io_service.run();
+
+    BOOST_TEST(
+        sut.received_bytes() == v13::messages::barrier_request{}.length());
+}
+
+BOOST_AUTO_TEST_CASE(writes_message_sent_outside_strand)
+{
+    connected_channel sut{flush_at_handler_exit()};
+
+    sut.channel->async_send(v13::messages::barrier_request{});
+    sut.channel->async_send(v13::messages::barrier_request{});
+    sut.io_service.run();
+
+    BOOST_TEST(
+        sut.received_bytes() == 2 * v13::messages::barrier_request{}.length());
+}
+
+BOOST_AUTO_TEST_CASE(writes_encoded_messages_as_one_buffer)
+{
+    connected_channel sut{controller::write_coalescing_options{}};
+    auto bytes = std::vector<unsigned char>{};
+    v13::messages::barrier_request{}.encode(bytes);
+    v13::messages::barrier_request{}.encode(bytes);
+    auto const type = v13::messages::barrier_request::message_type;
+
+    sut.channel->async_send_encoded(std::move(bytes));
+    sut.io_service.run();
+
+    BOOST_TEST(
+        sut.received_bytes() == 2 * v13::messages::barrier_request{}.length());
+    auto const metrics = boost::asio::use_service<
+      controller::channel_metrics_registry
+    >(sut.io_service).collect();
+    BOOST_TEST(metrics.total.sent[type].messages == 2);
+}
+
+BOOST_AUTO_TEST_SUITE(write_backpressure)
+
+BOOST_AUTO_TEST_CASE(unwritable_from_high_to_low_water_mark)
+{
+    connected_channel sut{
+        controller::write_coalescing_options{}, water_marks()
+    };
+
+    sut.channel->async_send(v13::messages::barrier_request{});
+    auto const is_writable_below_high = sut.channel->is_writable();
+    sut.channel->async_send(v13::messages::barrier_request{});
+    auto const is_writable_at_high = sut.channel->is_writable();
+    sut.io_service.run();
+
+    BOOST_TEST(is_writable_below_high);
+    BOOST_TEST(!is_writable_at_high);
+    BOOST_TEST(sut.channel->is_writable());
+    BOOST_TEST(sut.channel->write_queue_bytes() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(wait_writable_completes_when_written)
+{
+    connected_channel sut{
+        controller::write_coalescing_options{}, water_marks()
+    };
+    auto const channel = sut.channel;
+    sut.channel->async_send(v13::messages::barrier_request{});
+    sut.channel->async_send(v13::messages::barrier_request{});
+    auto error = boost::system::error_code{
+        boost::asio::error::would_block
+    };
+    auto is_writable = false;
+
+    sut.channel->async_wait_writable(
+            [&, channel](boost::system::error_code const& ec) {
+        error = ec;
+        is_writable = channel->is_writable();
+    });
+    sut.io_service.run();
+
+    BOOST_TEST(!error);
+    BOOST_TEST(is_writable);
+}
+
+BOOST_AUTO_TEST_CASE(wait_writable_is_aborted_by_close)
+{
+    connected_channel sut{
+        controller::write_coalescing_options{}, water_marks()
+    };
+    sut.channel->async_send(v13::messages::barrier_request{});
+    sut.channel->async_send(v13::messages::barrier_request{});
+    auto error = boost::system::error_code{};
+
+    sut.channel->async_wait_writable(
+            [&](boost::system::error_code const& ec) {
+        error = ec;
+    });
+    sut.channel->close();
+    sut.io_service.run();
+
+    BOOST_TEST(error == boost::asio::error::operation_aborted);
+}
+
+BOOST_AUTO_TEST_CASE(drops_packet_out_while_unwritable)
+{
+    connected_channel sut{
+        controller::write_coalescing_options{}
+      , water_marks().drop_packet_outs(true)
+    };
+    sut.channel->async_send(v13::messages::barrier_request{});
+    sut.channel->async_send(v13::messages::barrier_request{});
+    auto const result = write_result{
+        std::make_shared<boost::system::error_code>()
+      , std::make_shared<std::size_t>(1)
+    };
+
+    sut.channel->async_send(v13::messages::packet_out{}, result);
+    sut.io_service.run();
+
+    BOOST_TEST(*result.error == boost::asio::error::no_buffer_space);
+    BOOST_TEST(*result.written == 0);
+    BOOST_TEST(sut.dropped_messages() == 1);
+    BOOST_TEST(
+        sut.received_bytes() == 2 * v13::messages::barrier_request{}.length());
+}
+
+BOOST_AUTO_TEST_CASE(removes_packet_outs_from_encoded_messages)
+{
+    connected_channel sut{
+        controller::write_coalescing_options{}
+      , water_marks().drop_packet_outs(true)
+    };
+    sut.channel->async_send(v13::messages::barrier_request{});
+    sut.channel->async_send(v13::messages::barrier_request{});
+    auto bytes = std::vector<unsigned char>{};
+    v13::messages::packet_out{}.encode(bytes);
+    v13::messages::flow_add{}.encode(bytes);
+    v13::messages::packet_out{}.encode(bytes);
+    auto const result = write_result{
+        std::make_shared<boost::system::error_code>()
+      , std::make_shared<std::size_t>(0)
+    };
+
+    sut.channel->async_send_encoded(std::move(bytes), result);
+    sut.io_service.run();
+
+    BOOST_TEST(!*result.error);
+    BOOST_TEST(*result.written == v13::messages::flow_add{}.length());
+    BOOST_TEST(sut.dropped_messages() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(drops_message_sequence_of_only_packet_outs)
+{
+    connected_channel sut{
+        controller::write_coalescing_options{}
+      , water_marks().drop_packet_outs(true)
+    };
+    sut.channel->async_send(v13::messages::barrier_request{});
+    sut.channel->async_send(v13::messages::barrier_request{});
+    auto const packet_outs = std::vector<v13::messages::packet_out>(2);
+    auto const result = write_result{
+        std::make_shared<boost::system::error_code>()
+      , std::make_shared<std::size_t>(1)
+    };
+
+    sut.channel->async_send_all(packet_outs, result);
+    sut.io_service.run();
+
+    BOOST_TEST(*result.error == boost::asio::error::no_buffer_space);
+    BOOST_TEST(sut.dropped_messages() == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // write_backpressure
+
+BOOST_AUTO_TEST_SUITE_END() // secure_channel_test
@@ -0,0 +1,123 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/net/ofp/controller/v13/message_view.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace controller = canard::net::ofp::controller;
+namespace v13 = canard::net::ofp::v13;
+
+namespace {
+
+  void put16(std::vector<unsigned char>& bytes, std::uint16_t const value)
+  {
+    bytes.push_back(value >> 8);
+    bytes.push_back(value & 0xff);
+  }
+
+  void put32(std::vector<unsigned char>& bytes, std::uint32_t const value)
+  {
+    put16(bytes, value >> 16);
+    put16(bytes, value & 0xffff);
+  }
+
+  // packet_in whose match has an in_port field, followed by a 4 bytes frame
+  auto packet_in_bytes(std::uint16_t const match_length)
+    -> std::vector<unsigned char>
+  {
+    auto bytes = std::vector<unsigned char>{
+      v13::protocol::OFP_VERSION, v13::protocol::OFPT_PACKET_IN
+    };
+    put16(bytes, 46);
+    put32(bytes, 1);          // xid
+    put32(bytes, 0xffffffff); // buffer_id
+    put16(bytes, 4);          // total_len
+    bytes.push_back(0);       // reason
+    bytes.push_back(0);       // table_id
+    put32(bytes, 0);          // cookie
+    put32(bytes, 0);
+    put16(bytes, 1);          // match type
+    put16(bytes, match_length);
+    put32(bytes, 0x80000004); // in_port
+    put32(bytes, 3);
+    put32(bytes, 0);          // match padding
+    put16(bytes, 0);          // pad
+    put32(bytes, 0x01020304); // frame
+    return bytes;
+  }
+
+  template <class Message>
+  auto decode(std::vector<unsigned char> const& bytes)
+    -> decltype(controller::v13::message_view_detail::decode_message<Message>(
+          bytes.data(), bytes.data()))
+  {
+    return controller::v13::message_view_detail::decode_message<Message>(
+        bytes.data(), bytes.data() + bytes.size());
+  }
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(v13_message_view_test)
+
+BOOST_AUTO_TEST_CASE(decodes_packet_in_view)
+{
+    auto const bytes = packet_in_bytes(12);
+
+    auto const sut = decode<v13::messages::packet_in>(bytes);
+
+    BOOST_TEST(sut.in_port() == 3);
+    BOOST_TEST(sut.frame_length() == 4);
+}
+
+BOOST_AUTO_TEST_CASE(throws_if_match_is_longer_than_packet_in)
+{
+    auto const bytes = packet_in_bytes(200);
+
+    BOOST_CHECK_THROW(
+          decode<v13::messages::packet_in>(bytes)
+        , std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(throws_if_packet_in_is_truncated)
+{
+    auto bytes = packet_in_bytes(12);
+    bytes.resize(30);
+
+    BOOST_CHECK_THROW(
+          decode<v13::messages::packet_in>(bytes)
+        , std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(throws_if_flow_removed_is_truncated)
+{
+    auto bytes = std::vector<unsigned char>{
+      v13::protocol::OFP_VERSION, v13::protocol::OFPT_FLOW_REMOVED
+    };
+    put16(bytes, 16);
+    put32(bytes, 1);
+    put32(bytes, 0);
+    put32(bytes, 0);
+
+    BOOST_CHECK_THROW(
+          decode<v13::messages::flow_removed>(bytes)
+        , std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(throws_if_multipart_reply_is_truncated)
+{
+    auto bytes = std::vector<unsigned char>{
+      v13::protocol::OFP_VERSION, v13::protocol::OFPT_MULTIPART_REPLY
+    };
+    put16(bytes, 12);
+    put32(bytes, 1);
+    put16(bytes, 1);
+    put16(bytes, 0);
+
+    BOOST_CHECK_THROW(
+          decode<v13::messages::multipart::flow_stats_reply>(bytes)
+        , std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // v13_message_view_test
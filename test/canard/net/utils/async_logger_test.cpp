@@ -0,0 +1,150 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/net/utils/async_logger.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace utils = canard::net::utils;
+
+namespace {
+
+    using record = std::pair<utils::log_level, std::string>;
+
+    struct recording_sink
+    {
+        void operator()(utils::log_level level, std::string const& msg) const
+        {
+            records->emplace_back(level, msg);
+        }
+
+        std::shared_ptr<std::vector<record>> records;
+    };
+
+    // Clock which advances only when the test tells it to, so that all
+    // records of a test case fall in the same rate limit window.
+    struct manual_clock
+    {
+        using duration = std::chrono::nanoseconds;
+        using rep = duration::rep;
+        using period = duration::period;
+        using time_point = std::chrono::time_point<manual_clock>;
+        static constexpr bool is_steady = true;
+
+        static auto now() noexcept
+            -> time_point
+        {
+            return current;
+        }
+
+        static time_point current;
+    };
+
+    manual_clock::time_point manual_clock::current{};
+
+    using manual_clock_logger = utils::basic_async_logger<manual_clock>;
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(async_logger_test)
+
+BOOST_AUTO_TEST_CASE(log)
+{
+    auto const records = std::make_shared<std::vector<record>>();
+    {
+        utils::async_logger sut{recording_sink{records}};
+
+        sut.info("connection closed: ", 42);
+        sut.error("accept error");
+    }
+
+    BOOST_TEST_REQUIRE(records->size() == 2);
+    BOOST_TEST((records->at(0).first == utils::log_level::info));
+    BOOST_TEST(records->at(0).second == "connection closed: 42");
+    BOOST_TEST((records->at(1).first == utils::log_level::error));
+    BOOST_TEST(records->at(1).second == "accept error");
+}
+
+BOOST_AUTO_TEST_CASE(level)
+{
+    auto const records = std::make_shared<std::vector<record>>();
+    {
+        utils::async_logger sut{recording_sink{records}};
+        sut.level(utils::log_level::warning);
+
+        sut.debug("debug");
+        sut.info("info");
+        sut.warning("warning");
+    }
+
+    BOOST_TEST_REQUIRE(records->size() == 1);
+    BOOST_TEST(records->at(0).second == "warning");
+}
+
+BOOST_AUTO_TEST_CASE(rate_limit)
+{
+    auto const records = std::make_shared<std::vector<record>>();
+    {
+        manual_clock_logger sut{recording_sink{records}, 2};
+
+        sut.info("1");
+        sut.info("2");
+        sut.info("3");
+    }
+
+    BOOST_TEST_REQUIRE(records->size() == 3);
+    BOOST_TEST(records->at(1).second == "2");
+    BOOST_TEST((records->at(2).first == utils::log_level::warning));
+    BOOST_TEST(records->at(2).second == "1 log records dropped");
+}
+
+BOOST_AUTO_TEST_CASE(rate_limit_window_restarts_every_second)
+{
+    auto const records = std::make_shared<std::vector<record>>();
+    {
+        manual_clock_logger sut{recording_sink{records}, 1};
+
+        sut.info("1");
+        sut.info("2");
+        manual_clock::current += std::chrono::seconds{1};
+        sut.info("3");
+    }
+
+    // the flusher may report the drop before or after "3"
+    auto messages = std::vector<std::string>{};
+    for (auto const& r : *records) {
+        messages.push_back(r.second);
+    }
+    std::sort(messages.begin(), messages.end());
+    BOOST_TEST(messages == (std::vector<std::string>{
+                "1", "1 log records dropped", "3"
+            }), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(reclaims_queues_of_exited_threads)
+{
+    auto const records = std::make_shared<std::vector<record>>();
+    {
+        utils::async_logger sut{
+            recording_sink{records}, 0, std::chrono::milliseconds{1}
+        };
+
+        for (auto i = 0; i < 8; ++i) {
+            std::thread{[&sut, i]{ sut.info(i); }}.join();
+        }
+        for (auto i = 0; i < 1000 && sut.num_threads() != 0; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+
+        BOOST_TEST(sut.num_threads() == 0);
+    }
+
+    BOOST_TEST(records->size() == 8);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // async_logger_test
@@ -0,0 +1,102 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/net/utils/histogram.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace utils = canard::net::utils;
+
+BOOST_AUTO_TEST_SUITE(histogram_test)
+
+BOOST_AUTO_TEST_CASE(bucket_of)
+{
+    BOOST_TEST(utils::histogram_snapshot::bucket_of(0) == 0);
+    BOOST_TEST(utils::histogram_snapshot::bucket_of(7) == 7);
+    BOOST_TEST(utils::histogram_snapshot::bucket_of(8) == 8);
+    BOOST_TEST(utils::histogram_snapshot::bucket_of(15) == 15);
+    BOOST_TEST(utils::histogram_snapshot::bucket_of(16) == 16);
+    BOOST_TEST(utils::histogram_snapshot::bucket_of(17) == 16);
+    BOOST_TEST(utils::histogram_snapshot::bucket_of(18) == 17);
+    BOOST_TEST(utils::histogram_snapshot::bucket_of(1024) == 64);
+    BOOST_TEST(utils::histogram_snapshot::bucket_of(1200) == 65);
+    BOOST_TEST(utils::histogram_snapshot::bucket_of(
+                std::numeric_limits<std::uint64_t>::max())
+            == std::size_t{utils::histogram_snapshot::bucket_count} - 1);
+}
+
+BOOST_AUTO_TEST_CASE(bucket_limit)
+{
+    BOOST_TEST(utils::histogram_snapshot::bucket_limit(0) == 1);
+    BOOST_TEST(utils::histogram_snapshot::bucket_limit(15) == 16);
+    BOOST_TEST(utils::histogram_snapshot::bucket_limit(16) == 18);
+    BOOST_TEST(utils::histogram_snapshot::bucket_limit(64) == 1152);
+    BOOST_TEST(utils::histogram_snapshot::bucket_limit(
+                utils::histogram_snapshot::bucket_count - 1)
+            == std::numeric_limits<std::uint64_t>::max());
+}
+
+BOOST_AUTO_TEST_CASE(bucket_width_is_bounded_by_sub_buckets)
+{
+    for (auto value = std::uint64_t{8}; value < (1 << 20); value += 7) {
+        auto const bucket = utils::histogram_snapshot::bucket_of(value);
+        auto const limit = utils::histogram_snapshot::bucket_limit(bucket);
+        auto const lower = bucket == 0
+            ? 0 : utils::histogram_snapshot::bucket_limit(bucket - 1);
+        BOOST_TEST_REQUIRE(lower <= value);
+        BOOST_TEST_REQUIRE(value < limit);
+        BOOST_TEST_REQUIRE((limit - lower) * 8 <= lower);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(record)
+{
+    utils::histogram sut;
+
+    sut.record(0);
+    sut.record(5);
+    sut.record(6);
+
+    auto const snapshot = sut.snapshot();
+    BOOST_TEST(snapshot.count() == 3);
+    BOOST_TEST(snapshot.sum() == 11);
+    BOOST_TEST(snapshot.bucket(0) == 1);
+    BOOST_TEST(snapshot.bucket(5) == 1);
+    BOOST_TEST(snapshot.bucket(6) == 1);
+}
+
+BOOST_AUTO_TEST_CASE(quantile)
+{
+    utils::histogram sut;
+    for (auto i = 0; i < 90; ++i) {
+        sut.record(10);
+    }
+    for (auto i = 0; i < 10; ++i) {
+        sut.record(1000);
+    }
+
+    auto const snapshot = sut.snapshot();
+    BOOST_TEST(snapshot.quantile(0.5) == 11);
+    BOOST_TEST(snapshot.quantile(0.99) == 1024);
+    BOOST_TEST(utils::histogram_snapshot{}.quantile(0.5) == 0);
+}
+
+BOOST_AUTO_TEST_CASE(merge)
+{
+    utils::histogram h1;
+    utils::histogram h2;
+    h1.record(1);
+    h2.record(1);
+    h2.record(100);
+
+    auto snapshot = h1.snapshot();
+    snapshot.merge(h2.snapshot());
+
+    BOOST_TEST(snapshot.count() == 3);
+    BOOST_TEST(snapshot.sum() == 102);
+    BOOST_TEST(snapshot.bucket(1) == 2);
+    BOOST_TEST(snapshot.bucket(36) == 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // histogram_test
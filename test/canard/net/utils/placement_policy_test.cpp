@@ -0,0 +1,63 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/net/utils/placement_policy.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <vector>
+#include <boost/asio/io_service.hpp>
+#include <canard/net/utils/io_service_load.hpp>
+#include <canard/net/utils/io_service_pool.hpp>
+
+namespace utils = canard::net::utils;
+
+namespace {
+
+    auto connections_of(utils::io_service_pool& pool)
+        -> std::vector<std::size_t>
+    {
+        auto connections = std::vector<std::size_t>{};
+        for (auto i = std::size_t{0}; i < pool.io_service_count(); ++i) {
+            connections.push_back(
+                    boost::asio::use_service<utils::io_service_load>(
+                        pool.get_io_service(i)).connections());
+        }
+        return connections;
+    }
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(placement_policy_test)
+
+BOOST_AUTO_TEST_CASE(least_connections_spreads_connections_placed_back_to_back)
+{
+    utils::io_service_pool pool{4};
+    auto const sut = utils::least_connections_placement{};
+    auto placed = std::vector<utils::connection_count>{};
+
+    // no handshake completes between the placements
+    for (auto i = 0; i < 8; ++i) {
+        placed.emplace_back(sut(pool));
+    }
+
+    BOOST_TEST(connections_of(pool) == (std::vector<std::size_t>{2, 2, 2, 2})
+            , boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(connection_count_is_moved_to_its_owner)
+{
+    utils::io_service_pool pool{1};
+    auto& load = boost::asio::use_service<utils::io_service_load>(
+            pool.get_io_service(0));
+
+    {
+        auto placed = utils::connection_count{pool.get_io_service(0)};
+        {
+            auto const channel = utils::connection_count{std::move(placed)};
+            BOOST_TEST(load.connections() == 1);
+        }
+        BOOST_TEST(load.connections() == 0);
+    }
+    BOOST_TEST(load.connections() == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // placement_policy_test
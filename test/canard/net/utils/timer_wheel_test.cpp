@@ -0,0 +1,193 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/net/utils/timer_wheel.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/system/error_code.hpp>
+
+namespace utils = canard::net::utils;
+
+using clock_type = utils::wheel_timer::clock_type;
+
+namespace {
+
+    // Clock which advances only when the test tells it to, so that
+    // expiries of hours are tested without waiting for them.
+    struct manual_clock
+    {
+        using duration = std::chrono::nanoseconds;
+        using rep = duration::rep;
+        using period = duration::period;
+        using time_point = std::chrono::time_point<manual_clock>;
+        static constexpr bool is_steady = true;
+
+        static auto now() noexcept
+            -> time_point
+        {
+            return current;
+        }
+
+        static time_point current;
+    };
+
+    manual_clock::time_point manual_clock::current{};
+
+    // Makes asio check the manual clock every millisecond of real time.
+    struct manual_wait_traits
+    {
+        static auto to_wait_duration(manual_clock::duration const&)
+            -> manual_clock::duration
+        {
+            return std::chrono::milliseconds{1};
+        }
+
+        static auto to_wait_duration(manual_clock::time_point const&)
+            -> manual_clock::duration
+        {
+            return std::chrono::milliseconds{1};
+        }
+    };
+
+    using manual_timer
+        = utils::basic_wheel_timer<manual_clock, manual_wait_traits>;
+
+    // Advances the clock and runs the handlers which became ready.
+    void advance_clock(
+            boost::asio::io_service& io_service
+          , manual_clock::duration const& duration)
+    {
+        manual_clock::current += duration;
+        for (auto i = 0; i < 5; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            io_service.poll();
+            io_service.reset();
+        }
+    }
+
+    auto expires_exactly_after(manual_clock::duration const& duration)
+        -> bool
+    {
+        boost::asio::io_service io_service;
+        manual_timer sut{io_service};
+        auto is_expired = false;
+        sut.expires_from_now(duration);
+        sut.async_wait([&](boost::system::error_code const& ec) {
+            is_expired = !ec;
+        });
+
+        advance_clock(io_service, duration - std::chrono::milliseconds{1});
+        auto const is_early = is_expired;
+        advance_clock(io_service, std::chrono::milliseconds{1});
+        return !is_early && is_expired;
+    }
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(timer_wheel_test)
+
+BOOST_AUTO_TEST_CASE(expires_in_order_of_expiry_time)
+{
+    boost::asio::io_service io_service;
+    utils::wheel_timer t1{io_service};
+    utils::wheel_timer t2{io_service};
+    utils::wheel_timer t3{io_service};
+    auto order = std::vector<int>{};
+    auto const start = clock_type::now();
+
+    t1.expires_from_now(std::chrono::milliseconds{30});
+    t1.async_wait([&](boost::system::error_code const& ec) {
+        BOOST_TEST(!ec);
+        BOOST_TEST((clock_type::now() - start >= std::chrono::milliseconds{30}));
+        order.push_back(1);
+    });
+    t2.expires_from_now(std::chrono::milliseconds{10});
+    t2.async_wait([&](boost::system::error_code const& ec) {
+        BOOST_TEST(!ec);
+        order.push_back(2);
+    });
+    t3.expires_from_now(std::chrono::milliseconds{20});
+    t3.async_wait([&](boost::system::error_code const& ec) {
+        BOOST_TEST(!ec);
+        order.push_back(3);
+    });
+    io_service.run();
+
+    BOOST_TEST((order == std::vector<int>{2, 3, 1}));
+    BOOST_TEST(boost::asio::use_service<utils::timer_wheel_service>(
+                io_service).size() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(cancel_completes_wait_with_operation_aborted)
+{
+    boost::asio::io_service io_service;
+    utils::wheel_timer sut{io_service};
+    auto error = boost::system::error_code{};
+    sut.expires_from_now(std::chrono::hours{1});
+    sut.async_wait([&](boost::system::error_code const& ec) { error = ec; });
+
+    BOOST_TEST(sut.cancel() == 1);
+    io_service.run();
+
+    BOOST_TEST(error == boost::asio::error::operation_aborted);
+    BOOST_TEST(sut.cancel() == 0);
+}
+
+BOOST_AUTO_TEST_CASE(expires_timer_moved_down_from_upper_level)
+{
+    boost::asio::io_service io_service;
+    utils::wheel_timer sut{io_service};
+    auto elapsed = clock_type::duration{};
+    auto const start = clock_type::now();
+    sut.expires_from_now(std::chrono::milliseconds{150});
+    sut.async_wait([&](boost::system::error_code const& ec) {
+        BOOST_TEST(!ec);
+        elapsed = clock_type::now() - start;
+    });
+    io_service.run();
+
+    BOOST_TEST((elapsed >= std::chrono::milliseconds{150}));
+    BOOST_TEST((elapsed < std::chrono::milliseconds{300}));
+}
+
+BOOST_AUTO_TEST_CASE(expires_timer_moved_down_at_its_expiry_tick)
+{
+    BOOST_TEST(expires_exactly_after(std::chrono::milliseconds{64}));
+    BOOST_TEST(expires_exactly_after(std::chrono::milliseconds{4096}));
+}
+
+BOOST_AUTO_TEST_CASE(expires_timer_moved_down_from_level_two)
+{
+    BOOST_TEST(expires_exactly_after(std::chrono::milliseconds{5000}));
+}
+
+BOOST_AUTO_TEST_CASE(expires_timer_moved_down_from_level_three)
+{
+    BOOST_TEST(expires_exactly_after(std::chrono::milliseconds{300000}));
+}
+
+BOOST_AUTO_TEST_CASE(expires_timer_beyond_wheel_span)
+{
+    // the wheel spans 2^24 ticks of 1ms, about 4.7 hours
+    BOOST_TEST(expires_exactly_after(std::chrono::hours{5}));
+}
+
+BOOST_AUTO_TEST_CASE(pending_wait_without_expiry_keeps_io_service_running)
+{
+    boost::asio::io_service io_service;
+    utils::wheel_timer sut{io_service};
+    auto error = boost::system::error_code{};
+    sut.async_wait([&](boost::system::error_code const& ec) { error = ec; });
+
+    io_service.poll();
+    BOOST_TEST(!io_service.stopped());
+
+    sut.cancel();
+    io_service.run();
+    BOOST_TEST(error == boost::asio::error::operation_aborted);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // timer_wheel_test
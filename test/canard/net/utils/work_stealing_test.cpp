@@ -0,0 +1,88 @@
+#define BOOST_TEST_DYN_LINK
+#include <canard/net/utils/work_stealing.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <boost/asio/io_service.hpp>
+#include <canard/net/utils/io_service_pool.hpp>
+
+namespace utils = canard::net::utils;
+
+namespace {
+
+    // Records the threads which ran the handlers.
+    struct thread_recorder
+    {
+        void record()
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            thread_ids.insert(std::this_thread::get_id());
+        }
+
+        auto num_threads()
+            -> std::size_t
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            return thread_ids.size();
+        }
+
+        std::mutex mutex;
+        std::set<std::thread::id> thread_ids;
+    };
+
+} // unnamed namespace
+
+BOOST_AUTO_TEST_SUITE(work_stealing_test)
+
+BOOST_AUTO_TEST_CASE(rejects_pool_not_constructed_for_work_stealing)
+{
+    utils::io_service_pool pool{2};
+
+    BOOST_CHECK_THROW(
+            utils::work_stealing_runner{pool}, std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(accepts_pool_of_single_io_service)
+{
+    utils::io_service_pool pool{1, 2};
+
+    BOOST_CHECK_NO_THROW(utils::work_stealing_runner{pool});
+}
+
+BOOST_AUTO_TEST_CASE(blocked_thread_steals_handlers_left_ready)
+{
+    utils::io_service_pool pool{2, 1, true};
+    thread_recorder recorder{};
+    auto done = std::promise<void>{};
+    std::atomic<std::size_t> remaining{8};
+
+    {
+        auto const work = utils::io_service_pool::work{pool};
+        pool.start(false, utils::work_stealing_runner{pool});
+        // lets both threads block on their idle io_services
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        for (auto i = 0; i < 8; ++i) {
+            pool.get_io_service(0).post([&] {
+                recorder.record();
+                std::this_thread::sleep_for(std::chrono::milliseconds{5});
+                if (--remaining == 0) {
+                    done.set_value();
+                }
+            });
+        }
+        done.get_future().wait();
+        pool.stop();
+        pool.reset();
+    }
+
+    BOOST_TEST(recorder.num_threads() == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // work_stealing_test